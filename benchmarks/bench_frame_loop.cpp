@@ -0,0 +1,23 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "game/game.hpp"
+
+TEST_CASE("Game frame loop", "[benchmark][Game]")
+{
+    BENCHMARK_ADVANCED("headless PlayState, 1000 ticks")(Catch::Benchmark::Chronometer meter)
+    {
+        Game game;
+        game.initialize(GameBackend::Headless);
+        meter.measure([&game]
+                      { game.run(1000); });
+    };
+
+    BENCHMARK_ADVANCED("headless PlayState with profiler, 1000 ticks")(Catch::Benchmark::Chronometer meter)
+    {
+        Game game;
+        game.initialize(GameBackend::Headless);
+        game.setProfilerEnabled(true);
+        meter.measure([&game]
+                      { game.run(1000); });
+    };
+}
\ No newline at end of file
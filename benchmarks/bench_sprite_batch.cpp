@@ -0,0 +1,23 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include "rendering/sprite_batch.hpp"
+
+TEST_CASE("SpriteBatch queue and sort", "[benchmark][SpriteBatch]")
+{
+    SpriteBatch batch;
+
+    // Interleaved textures are the worst case for grouping: every sprite
+    // starts a new run until the sort puts them together.
+    for (int spriteCount : {1000, 10000})
+    {
+        BENCHMARK("queue and sort " + std::to_string(spriteCount) + " sprites over 8 textures")
+        {
+            batch.begin(glm::vec2(1920.0f, 1080.0f), glm::ivec2(1920, 1080));
+            for (int i = 0; i < spriteCount; ++i)
+                batch.draw(static_cast<GLuint>(1 + i % 8), glm::vec2(static_cast<float>(i % 1920), static_cast<float>(i % 1080)), glm::vec2(16.0f));
+            batch.end();
+            return batch.getDrawRanges().size();
+        };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include "game/states/state_stack.hpp"
+#include "game/states/variant_state_stack.hpp"
+
+namespace
+{
+    class EmptyState : public GameState
+    {
+    public:
+        explicit EmptyState(bool coveredUpdates = false)
+            : coveredUpdates(coveredUpdates)
+        {
+        }
+
+        void update(float dt) override
+        {
+            elapsed += dt;
+        }
+
+        void render(float alpha) override
+        {
+            lastAlpha = alpha;
+        }
+
+        bool updatesWhenCovered() const override
+        {
+            return coveredUpdates;
+        }
+
+    private:
+        float elapsed = 0.0f,
+              lastAlpha = 0.0f;
+        bool coveredUpdates;
+    };
+
+    // Requests a burst of transitions from inside update, so they go through
+    // the deferred queue instead of being applied one by one.
+    class TransitionBurstState : public GameState
+    {
+    public:
+        TransitionBurstState(StateStack &stack, int pushCount)
+            : stack(stack), pushCount(pushCount)
+        {
+        }
+
+        void update(float dt) override
+        {
+            for (int i = 0; i < pushCount; ++i)
+                stack.push(std::make_unique<EmptyState>());
+            for (int i = 0; i < pushCount; ++i)
+                stack.pop();
+        }
+
+    private:
+        StateStack &stack;
+        int pushCount;
+    };
+
+    struct InlineState
+    {
+        float elapsed = 0.0f,
+              lastAlpha = 0.0f;
+        bool coveredUpdates = false;
+
+        void update(float dt) { elapsed += dt; }
+        void render(float alpha) { lastAlpha = alpha; }
+        bool updatesWhenCovered() const { return coveredUpdates; }
+    };
+
+    struct OtherInlineState
+    {
+        int frames = 0;
+
+        void render(float alpha) { ++frames; }
+    };
+
+    using InlineStateStack = VariantStateStack<InlineState, OtherInlineState>;
+
+    void fill(InlineStateStack &stack, int stateCount, bool coveredUpdates)
+    {
+        for (int i = 0; i < stateCount; ++i)
+            stack.push<InlineState>(0.0f, 0.0f, coveredUpdates);
+    }
+
+    void fill(StateStack &stack, int stateCount, bool coveredUpdates)
+    {
+        for (int i = 0; i < stateCount; ++i)
+            stack.push(std::make_unique<EmptyState>(coveredUpdates));
+    }
+}
+
+TEST_CASE("StateStack transitions", "[benchmark][StateStack]")
+{
+    BENCHMARK_ADVANCED("push then pop")(Catch::Benchmark::Chronometer meter)
+    {
+        StateStack stack;
+        stack.push(std::make_unique<EmptyState>());
+        meter.measure([&stack]
+                      {
+            stack.push(std::make_unique<EmptyState>());
+            stack.pop(); });
+    };
+
+    BENCHMARK_ADVANCED("replace")(Catch::Benchmark::Chronometer meter)
+    {
+        StateStack stack;
+        stack.push(std::make_unique<EmptyState>());
+        meter.measure([&stack]
+                      { stack.replace(std::make_unique<EmptyState>()); });
+    };
+
+    for (int pushCount : {1, 16, 256})
+    {
+        BENCHMARK_ADVANCED("queued burst of " + std::to_string(pushCount) + " pushes and pops")(Catch::Benchmark::Chronometer meter)
+        {
+            StateStack stack;
+            stack.push(std::make_unique<TransitionBurstState>(stack, pushCount));
+            meter.measure([&stack]
+                          { stack.update(0.016f); });
+        };
+    }
+}
+
+TEST_CASE("StateStack dispatch", "[benchmark][StateStack]")
+{
+    for (int stateCount : {1, 10, 100, 1000, 10000})
+    {
+        std::string suffix = " across " + std::to_string(stateCount) + " states";
+
+        BENCHMARK_ADVANCED("update top only" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            StateStack stack;
+            fill(stack, stateCount, false);
+            meter.measure([&stack]
+                          { stack.update(0.016f); });
+        };
+
+        BENCHMARK_ADVANCED("update covered states" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            StateStack stack;
+            fill(stack, stateCount, true);
+            meter.measure([&stack]
+                          { stack.update(0.016f); });
+        };
+
+        BENCHMARK_ADVANCED("render" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            StateStack stack;
+            fill(stack, stateCount, false);
+            meter.measure([&stack]
+                          { stack.render(1.0f); });
+        };
+    }
+}
+
+TEST_CASE("VariantStateStack dispatch", "[benchmark][VariantStateStack]")
+{
+    for (int stateCount : {1, 10, 100, 1000, 10000})
+    {
+        std::string suffix = " across " + std::to_string(stateCount) + " inline states";
+
+        BENCHMARK_ADVANCED("update covered states" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            InlineStateStack stack;
+            fill(stack, stateCount, true);
+            meter.measure([&stack]
+                          { stack.update(0.016f); });
+        };
+
+        BENCHMARK_ADVANCED("render" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            InlineStateStack stack;
+            fill(stack, stateCount, false);
+            meter.measure([&stack]
+                          { stack.render(1.0f); });
+        };
+    }
+
+    BENCHMARK_ADVANCED("push then pop inline")(Catch::Benchmark::Chronometer meter)
+    {
+        InlineStateStack stack;
+        stack.push<InlineState>();
+        meter.measure([&stack]
+                      {
+            stack.push<OtherInlineState>();
+            stack.pop(); });
+    };
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <vector>
+#include "rendering/block_compression.hpp"
+#include "rendering/cooked_texture.hpp"
+#include "rendering/image.hpp"
+
+namespace
+{
+    std::vector<unsigned char> makeGradient(int width, int height)
+    {
+        std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                unsigned char *pixel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+                pixel[0] = static_cast<unsigned char>(x * 255 / width);
+                pixel[1] = static_cast<unsigned char>(y * 255 / height);
+                pixel[2] = static_cast<unsigned char>((x ^ y) & 0xFF);
+                pixel[3] = 255;
+            }
+        }
+        return pixels;
+    }
+}
+
+TEST_CASE("Texture decoding", "[benchmark][Texture]")
+{
+    const std::string logoPath = GAMESTATE_SOURCE_DIR "/assets/textures/man_on_a_beach_logo.jpg";
+    if (std::filesystem::exists(logoPath))
+    {
+        BENCHMARK("stb_image decode of the splash logo")
+        {
+            return Image(logoPath, true);
+        };
+    }
+
+    std::vector<unsigned char> pixels = makeGradient(1024, 1024);
+    std::vector<unsigned char> bc1 = compressBC1(1024, 1024, pixels.data());
+    std::vector<unsigned char> cooked = CookedTexture::cook(1024, 1024, pixels.data(), CookedTextureFormat::BC1, true);
+
+    BENCHMARK("BC1 compress 1024x1024")
+    {
+        return compressBC1(1024, 1024, pixels.data());
+    };
+
+    BENCHMARK("BC1 decompress 1024x1024")
+    {
+        return decompressBC1(1024, 1024, bc1.data());
+    };
+
+    BENCHMARK("parse cooked 1024x1024 BC1 with mips")
+    {
+        return CookedTexture(cooked);
+    };
+}
\ No newline at end of file
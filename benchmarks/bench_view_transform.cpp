@@ -0,0 +1,47 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include "rendering/ui/view_transform.hpp"
+
+TEST_CASE("ViewTransform batch conversion", "[benchmark][ViewTransform]")
+{
+    const glm::vec2 cameraTopLeft(-120.0f, 64.0f), uiScale(2.0f, 1.5f);
+    constexpr float zoom = 1.25f;
+    constexpr size_t pointCount = 10000;
+
+    std::vector<glm::vec2> world(pointCount);
+    std::vector<float> worldX(pointCount), worldY(pointCount);
+    for (size_t i = 0; i < pointCount; ++i)
+    {
+        world[i] = glm::vec2(static_cast<float>(i % 1920), static_cast<float>(i % 1080));
+        worldX[i] = world[i].x;
+        worldY[i] = world[i].y;
+    }
+    std::vector<ImVec2> screen(pointCount);
+    std::vector<float> screenX(pointCount), screenY(pointCount);
+
+    // What callers did before: the UI scale recomputed for every point.
+    BENCHMARK("per point, 10000 points")
+    {
+        for (size_t i = 0; i < pointCount; ++i)
+        {
+            glm::vec2 position = ((world[i] - cameraTopLeft) * zoom) / uiScale;
+            screen[i] = ImVec2(position.x, position.y);
+        }
+        return screen.back().x;
+    };
+
+    const std::string isa = getViewTransformIsa();
+    BENCHMARK("batch AoS (" + isa + "), 10000 points")
+    {
+        worldToScreen(ViewTransform::create(zoom, cameraTopLeft, uiScale), world, screen);
+        return screen.back().x;
+    };
+
+    BENCHMARK("batch SoA (" + isa + "), 10000 points")
+    {
+        worldToScreen(ViewTransform::create(zoom, cameraTopLeft, uiScale), worldX, worldY, screenX, screenY);
+        return screenX.back();
+    };
+}
\ No newline at end of file
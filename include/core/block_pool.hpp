@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Fixed-size blocks carved out of chunks that are never moved or freed until
+// the pool dies, so a block's address stays valid for its whole life and a
+// freed block is handed straight back to the next allocation.
+class BlockPool
+{
+public:
+    BlockPool(size_t blockSize, size_t blockAlignment, size_t blocksPerChunk = 8);
+    ~BlockPool();
+    BlockPool(const BlockPool &) = delete;
+    BlockPool &operator=(const BlockPool &) = delete;
+    void *allocate();
+    void deallocate(void *block);
+    size_t getBlockSize() const;
+    size_t getCapacity() const;
+    size_t getLiveCount() const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    void addChunk();
+
+    size_t blockSize, blockAlignment, blockStride, blocksPerChunk;
+    std::vector<void *> chunks;
+    FreeBlock *freeList = nullptr;
+    size_t liveCount = 0;
+    mutable std::mutex mutex;
+};
\ No newline at end of file
@@ -0,0 +1,250 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+class EventBus;
+
+// Unsubscribes when destroyed, so a state holding one as a member stops
+// receiving events when it is destroyed, not when it is paused or covered.
+class Subscription
+{
+public:
+    Subscription() = default;
+    Subscription(EventBus &bus, size_t typeId, uint64_t id)
+        : bus(&bus), typeId(typeId), id(id)
+    {
+    }
+    ~Subscription()
+    {
+        reset();
+    }
+    Subscription(Subscription &&other) noexcept
+        : bus(std::exchange(other.bus, nullptr)), typeId(other.typeId), id(other.id)
+    {
+    }
+    Subscription &operator=(Subscription &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            bus = std::exchange(other.bus, nullptr);
+            typeId = other.typeId;
+            id = other.id;
+        }
+        return *this;
+    }
+    Subscription(const Subscription &) = delete;
+    Subscription &operator=(const Subscription &) = delete;
+    void reset();
+    bool isActive() const
+    {
+        return bus != nullptr;
+    }
+
+private:
+    EventBus *bus = nullptr;
+    size_t typeId = 0;
+    uint64_t id = 0;
+};
+
+// Typed events, dispatched either immediately with publish or later with
+// enqueue and dispatchQueued. Subscribing, publishing and dispatching belong
+// to one thread, the main thread in Game; enqueue may be called from any
+// thread and goes through a lock-free multi-producer queue. Handlers may
+// publish, enqueue, subscribe and unsubscribe; subscriptions made during a
+// dispatch see the next event, not the current one.
+class EventBus
+{
+public:
+    EventBus();
+    ~EventBus();
+    EventBus(const EventBus &) = delete;
+    EventBus &operator=(const EventBus &) = delete;
+
+    template <typename Event>
+    [[nodiscard]] Subscription subscribe(std::function<void(const Event &)> handler)
+    {
+        if (!handler)
+            throw std::invalid_argument("EventBus: subscribe received an empty handler");
+
+        Channel<Event> &channel = getChannel<Event>();
+        uint64_t id = nextSubscriptionId++;
+        (channel.dispatchDepth > 0 ? channel.added : channel.handlers).push_back({id, std::move(handler)});
+        return Subscription(*this, getTypeId<Event>(), id);
+    }
+
+    template <typename Event>
+    void publish(const Event &event)
+    {
+        size_t typeId = getTypeId<Event>();
+        if (typeId >= channels.size() || !channels[typeId])
+            return;
+
+        auto &channel = static_cast<Channel<Event> &>(*channels[typeId]);
+        ++channel.dispatchDepth;
+        // Indexing rather than iterating: handlers added meanwhile go to
+        // the side list and removed ones are only flagged, so the vector,
+        // and the handler running now, stay put while it is walked.
+        for (size_t i = 0; i < channel.handlers.size(); ++i)
+        {
+            if (!channel.handlers[i].removed)
+                channel.handlers[i].function(event);
+        }
+        --channel.dispatchDepth;
+
+        if (channel.dispatchDepth == 0)
+            channel.settle();
+    }
+
+    // Called when something was queued; Game uses it to wake an idle loop.
+    // Runs on the enqueuing thread.
+    void setEnqueueCallback(std::function<void()> callback);
+
+    template <typename Event>
+    void enqueue(Event event)
+    {
+        push(new QueuedEvent<Event>(std::move(event)));
+        if (enqueueCallback)
+            enqueueCallback();
+    }
+
+    // Publishes everything queued before the call, in order per producer.
+    // Events queued by the handlers wait for the next call. Returns the
+    // number of events dispatched.
+    size_t dispatchQueued();
+    size_t getSubscriberCount() const;
+
+private:
+    friend class Subscription;
+
+    struct ChannelBase
+    {
+        virtual ~ChannelBase() = default;
+        virtual bool remove(uint64_t id) = 0;
+        virtual size_t size() const = 0;
+    };
+
+    template <typename Event>
+    struct Channel : ChannelBase
+    {
+        struct Handler
+        {
+            uint64_t id;
+            std::function<void(const Event &)> function;
+            bool removed = false;
+        };
+
+        std::vector<Handler> handlers,
+            added;
+        int dispatchDepth = 0;
+        bool hasRemoved = false;
+
+        bool remove(uint64_t id) override
+        {
+            for (auto *list : {&handlers, &added})
+            {
+                for (auto it = list->begin(); it != list->end(); ++it)
+                {
+                    if (it->id != id || it->removed)
+                        continue;
+
+                    if (dispatchDepth > 0 && list == &handlers)
+                    {
+                        it->removed = true;
+                        hasRemoved = true;
+                    }
+                    else
+                    {
+                        list->erase(it);
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        size_t size() const override
+        {
+            size_t count = added.size();
+            for (const Handler &handler : handlers)
+                count += handler.removed ? 0 : 1;
+            return count;
+        }
+
+        void settle()
+        {
+            if (hasRemoved)
+            {
+                std::erase_if(handlers, [](const Handler &handler)
+                              { return handler.removed; });
+                hasRemoved = false;
+            }
+            for (Handler &handler : added)
+                handlers.push_back(std::move(handler));
+            added.clear();
+        }
+    };
+
+    // Intrusive node of the queue; each queued event is its own node.
+    struct QueuedEventBase
+    {
+        virtual ~QueuedEventBase() = default;
+        virtual void dispatch(EventBus &bus) = 0;
+        std::atomic<QueuedEventBase *> next = nullptr;
+    };
+
+    template <typename Event>
+    struct QueuedEvent : QueuedEventBase
+    {
+        explicit QueuedEvent(Event event) : event(std::move(event)) {}
+        void dispatch(EventBus &bus) override
+        {
+            bus.publish(event);
+        }
+        Event event;
+    };
+
+    struct Stub : QueuedEventBase
+    {
+        void dispatch(EventBus &) override {}
+    };
+
+    template <typename Event>
+    static size_t getTypeId()
+    {
+        static const size_t id = nextTypeId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    template <typename Event>
+    Channel<Event> &getChannel()
+    {
+        size_t typeId = getTypeId<Event>();
+        if (typeId >= channels.size())
+            channels.resize(typeId + 1);
+        if (!channels[typeId])
+            channels[typeId] = std::make_unique<Channel<Event>>();
+        return static_cast<Channel<Event> &>(*channels[typeId]);
+    }
+
+    void unsubscribe(size_t typeId, uint64_t id);
+    void push(QueuedEventBase *node);
+    QueuedEventBase *pop();
+
+    static inline std::atomic<size_t> nextTypeId = 0;
+
+    std::vector<std::unique_ptr<ChannelBase>> channels;
+    uint64_t nextSubscriptionId = 1;
+    std::function<void()> enqueueCallback;
+    // Vyukov's intrusive MPSC queue: producers swap themselves in at head,
+    // the consumer walks from tail. The stub keeps it from ever being empty.
+    Stub stub;
+    alignas(64) std::atomic<QueuedEventBase *> head;
+    alignas(64) QueuedEventBase *tail;
+};
\ No newline at end of file
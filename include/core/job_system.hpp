@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tracks a set of jobs so one caller can wait for all of them. The first
+// exception thrown by any job is rethrown from JobSystem::wait.
+class JobGroup
+{
+public:
+    bool isDone() const;
+
+private:
+    friend class JobSystem;
+
+    std::atomic<size_t> pending = 0;
+    std::exception_ptr error;
+    std::mutex errorMutex;
+};
+
+// Short CPU jobs on a fixed set of workers. Every thread pushes to and pops
+// from the back of its own queue, and idle workers steal from the front of
+// the others. Threads that are not workers share queue 0. Waiting threads
+// run jobs instead of blocking, so jobs may spawn and wait for more jobs.
+class JobSystem
+{
+public:
+    explicit JobSystem(size_t workerCount);
+    ~JobSystem();
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+    void run(JobGroup &group, std::function<void()> job);
+    void wait(JobGroup &group);
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)> &body);
+    size_t getWorkerCount() const;
+
+private:
+    struct Job
+    {
+        std::function<void()> function;
+        JobGroup *group = nullptr;
+    };
+
+    struct Queue
+    {
+        std::deque<Job> jobs;
+        std::mutex mutex;
+    };
+
+    size_t getQueueIndex() const;
+    bool tryRunJob(size_t queueIndex);
+    bool takeJob(size_t queueIndex, Job &job);
+    void execute(Job &job);
+    void workerLoop(size_t queueIndex);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::ptrdiff_t> queuedJobs = 0;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string &filePath);
+    ~MappedFile();
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    const unsigned char *data() const;
+    size_t size() const;
+    bool isOpen() const;
+
+private:
+    void close();
+
+    const unsigned char *bytes = nullptr;
+    size_t byteSize = 0;
+    bool open = false;
+#ifdef _WIN32
+    void *fileHandle = nullptr,
+         *mappingHandle = nullptr;
+#endif
+};
\ No newline at end of file
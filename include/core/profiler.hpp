@@ -0,0 +1,94 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+struct TimingStats
+{
+    double last = 0.0,
+           p50 = 0.0,
+           p95 = 0.0,
+           p99 = 0.0;
+    size_t sampleCount = 0;
+};
+
+struct ProfileStats
+{
+    std::string label;
+    TimingStats cpu, gpu;
+};
+
+class Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Profiler(size_t historySize = 240);
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    void beginFrame();
+    // name and detail are kept by pointer, so pass string literals.
+    void record(const char *name, const char *detail, double seconds);
+    void recordGpu(const char *name, const char *detail, double seconds);
+    std::vector<ProfileStats> getStats() const;
+    size_t getHistorySize() const;
+    void clear();
+
+private:
+    struct SampleRing
+    {
+        std::vector<double> samples;
+        size_t sampleCount = 0,
+               nextSample = 0;
+        double current = 0.0;
+        bool touched = false;
+
+        void add(double seconds);
+        void commit();
+        TimingStats getStats(std::vector<double> &scratch) const;
+    };
+
+    struct Section
+    {
+        const char *name;
+        const char *detail;
+        std::string label;
+        SampleRing cpu, gpu;
+    };
+
+    Section &findSection(const char *name, const char *detail);
+
+    std::vector<Section> sections;
+    size_t historySize;
+    bool enabled = false;
+};
+
+// Times the enclosing scope into the current frame. Costs one branch when the
+// profiler is missing or disabled.
+class ProfileScope
+{
+public:
+    ProfileScope(Profiler *profiler, const char *name, const char *detail = nullptr)
+        : profiler(profiler && profiler->isEnabled() ? profiler : nullptr),
+          name(name),
+          detail(detail)
+    {
+        if (this->profiler)
+            start = Profiler::Clock::now();
+    }
+
+    ~ProfileScope()
+    {
+        if (profiler)
+            profiler->record(name, detail, std::chrono::duration<double>(Profiler::Clock::now() - start).count());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    Profiler *profiler;
+    const char *name,
+        *detail;
+    Profiler::Clock::time_point start;
+};
\ No newline at end of file
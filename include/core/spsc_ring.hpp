@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Fixed-capacity lock-free queue for exactly one producer thread and one
+// consumer thread. Capacity is rounded up to a power of two; pushing into a
+// full ring fails instead of allocating or blocking.
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("SpscRing: capacity must be positive");
+
+        size_t roundedCapacity = 1;
+        while (roundedCapacity < capacity)
+            roundedCapacity <<= 1;
+
+        slots.resize(roundedCapacity);
+        mask = roundedCapacity - 1;
+    }
+
+    bool tryPush(const T &value)
+    {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == slots.size())
+            return false;
+
+        slots[currentTail & mask] = value;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T &value)
+    {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire))
+            return false;
+
+        value = slots[currentHead & mask];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    size_t getCapacity() const
+    {
+        return slots.size();
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask = 0;
+    // Kept on separate cache lines so the two threads do not false-share.
+    alignas(64) std::atomic<size_t> head = 0;
+    alignas(64) std::atomic<size_t> tail = 0;
+};
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free hand-off of the latest value from one writer thread to one reader
+// thread. The writer fills getWriteBuffer() and publish()es it; the reader
+// calls acquire() and reads getReadBuffer(). Neither side ever waits, the
+// reader always sees the newest complete value, and buffers are reused, so
+// steady-state hand-offs do not allocate.
+template <typename T>
+class TripleBuffer
+{
+public:
+    T &getWriteBuffer()
+    {
+        return buffers[writeIndex];
+    }
+
+    void publish()
+    {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(writeIndex | freshBit), std::memory_order_acq_rel);
+        writeIndex = previous & indexMask;
+    }
+
+    // Returns true if a newer value was published since the last acquire.
+    bool acquire()
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0)
+            return false;
+
+        uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & indexMask;
+        return true;
+    }
+
+    const T &getReadBuffer() const
+    {
+        return buffers[readIndex];
+    }
+
+    T &getReadBuffer()
+    {
+        return buffers[readIndex];
+    }
+
+private:
+    static constexpr uint8_t indexMask = 0x3,
+                             freshBit = 0x4;
+
+    std::array<T, 3> buffers{};
+    uint8_t writeIndex = 0,
+            readIndex = 1;
+    std::atomic<uint8_t> middle = 2;
+};
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "rendering/texture_cache.hpp"
+
+struct TextureAsset
+{
+    std::string name;
+    std::string filePath;
+    bool flipY = false;
+};
+
+struct AssetManifest
+{
+    std::vector<TextureAsset> textures;
+};
+
+class LoadedAssets
+{
+public:
+    void addTexture(const std::string &name, std::shared_ptr<TextureHandle> texture)
+    {
+        if (!texture)
+            throw std::invalid_argument("LoadedAssets: addTexture received nullptr TextureHandle");
+
+        textures[name] = std::move(texture);
+    }
+
+    std::shared_ptr<TextureHandle> getTexture(const std::string &name) const
+    {
+        auto it = textures.find(name);
+        if (it == textures.end())
+            throw std::runtime_error("LoadedAssets: no texture named " + name);
+
+        return it->second;
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<TextureHandle>> textures;
+};
\ No newline at end of file
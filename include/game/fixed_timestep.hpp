@@ -0,0 +1,20 @@
+#pragma once
+
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(double tickRate = 60.0, int maxCatchUpSteps = 5);
+    int advance(double frameTime);
+    void reset();
+    void setTickRate(double tickRate);
+    void setMaxCatchUpSteps(int maxCatchUpSteps);
+    double getTickRate() const;
+    double getStepSize() const;
+    int getMaxCatchUpSteps() const;
+    float getAlpha() const;
+
+private:
+    double stepSize = 1.0 / 60.0,
+           accumulator = 0.0;
+    int maxCatchUpSteps = 5;
+};
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+enum class PresentMode
+{
+    Vsync,
+    // Vsync that tears instead of waiting a whole extra refresh when a frame
+    // is late. Falls back to plain vsync where the driver lacks it.
+    AdaptiveVsync,
+    Uncapped,
+    // Uncapped swaps, paced on the CPU to a fixed frame rate.
+    Capped
+};
+
+struct FramePacingStats
+{
+    size_t frameCount = 0,
+           missedDeadlines = 0;
+    double lastFrameTime = 0.0,
+           lastWorkTime = 0.0;
+};
+
+// Decides when a frame starts and when it is presented. Game calls
+// beginFrame before polling input, waitForPresent before swapping and
+// framePresented right after.
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr double defaultFrameRateCap = 120.0;
+
+    FramePacer();
+    void setMode(PresentMode mode);
+    PresentMode getMode() const;
+    void setFrameRateCap(double framesPerSecond);
+    double getFrameRateCap() const;
+    void setRefreshRate(double refreshRate);
+    double getRefreshRate() const;
+    void setAdaptiveVsyncSupported(bool supported);
+    // Late latching delays the start of a frame, and with it input polling,
+    // until just enough time is left to finish it before the deadline.
+    void setLateLatchEnabled(bool enabled);
+    bool isLateLatchEnabled() const;
+    int getSwapInterval() const;
+    double getTargetFrameTime() const;
+    void beginFrame();
+    void waitForPresent();
+    void framePresented(Clock::time_point presentTime = Clock::now());
+    const FramePacingStats &getStats() const;
+    void reset();
+    // Called after the loop slept waiting for events. Drops the deadline,
+    // which is stale by then, and leaves the gap out of the frame stats.
+    void resumeAfterIdle();
+
+    // Sleeps most of the way, then spins the rest: OS sleeps routinely
+    // overshoot by a millisecond or more.
+    static void waitUntil(Clock::time_point deadline);
+
+private:
+    PresentMode mode = PresentMode::Vsync;
+    double frameRateCap = defaultFrameRateCap,
+           refreshRate = 60.0,
+           predictedWorkTime = 0.0;
+    bool adaptiveVsyncSupported = false,
+         lateLatchEnabled = false,
+         hasDeadline = false,
+         resumedAfterIdle = false;
+    Clock::time_point deadline, lastPresentTime, workStartTime;
+    FramePacingStats stats;
+};
\ No newline at end of file
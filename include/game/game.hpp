@@ -1,30 +1,128 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include "core/event_bus.hpp"
+#include "core/job_system.hpp"
+#include "core/profiler.hpp"
+#include "game/fixed_timestep.hpp"
+#include "game/frame_pacer.hpp"
+#include "game/game_events.hpp"
+#include "game/settings.hpp"
+#include "game/states/profiler_overlay_state.hpp"
 #include "game/states/state_stack.hpp"
+#include "input/input_system.hpp"
+#include "rendering/gpu_profiler.hpp"
+#include "rendering/render_thread.hpp"
+#include "rendering/sprite_batch.hpp"
+#include "rendering/sprite_renderer.hpp"
+#include "rendering/texture_cache.hpp"
+#include "rendering/texture_loader.hpp"
 #include "rendering/ui/imgui_manager.hpp"
 
 struct GLFWwindow;
 
+enum class GameBackend
+{
+    Windowed,
+    // No GLFW, GL or textures. Ticks run back to back on a fake clock, so
+    // state logic can be soak-tested on machines without a display.
+    Headless
+};
+
 class Game
 {
 public:
     Game();
     ~Game();
-    void run();
+    void run(size_t tickLimit = 0);
     std::unique_ptr<GameState> makeOptionsState();
     void setFullscreen(bool fullscreen);
     StateStack &getStateStack();
-    void initialize();
+    FixedTimestep &getFixedTimestep();
+    FramePacer &getFramePacer();
+    TextureLoader &getTextureLoader();
+    TextureCache &getTextureCache();
+    JobSystem &getJobSystem();
+    InputSystem &getInput();
+    // Queued events are dispatched once a frame, after the updates and
+    // before rendering.
+    EventBus &getEvents();
+    SettingsStore &getSettings();
+    // Sprites queued from render() are drawn under the ImGui pass.
+    SpriteBatch &getSpriteBatch();
+    ImGuiManager &getImGuiManager();
+    void setFixedTimestepEnabled(bool enabled);
+    Profiler &getProfiler();
+    void setProfilerEnabled(bool enabled);
+    // Draw and present on a render thread while the next frame simulates.
+    // Takes effect at the start of the next frame; windowed only.
+    void setPipelinedRendering(bool enabled);
+    bool isPipelinedRendering() const;
+    void initialize(GameBackend backend = GameBackend::Windowed);
+    GameBackend getBackend() const;
+    void requestClose();
+    // Asks for at least one more frame while the game is idling. Safe to
+    // call from any thread.
+    void requestRedraw();
 
 protected:
-    void setupGLFW(int windowWidth, int windowHeight);
+    void setupGLFW(const Settings &settings);
     void setupGlad();
+    void setupInput();
+    bool processInput();
+    // Returns whether the loop slept waiting for events.
+    bool waitForWork();
+    double getIdleTimeout() const;
+    void handleInput(const InputEvent &event);
     void update(float deltaTime);
-    void render();
+    void render(float alpha);
+    void buildFrame(float alpha);
+    void drawSnapshot(FrameSnapshot &snapshot);
+    void applyPipelinedRendering();
     void resize(int width, int height);
+    double advanceClock();
+    bool shouldClose() const;
+    void present();
+    void applySwapInterval();
 
-    GLFWwindow *window;
+    GameBackend backend = GameBackend::Windowed;
+    GLFWwindow *window = nullptr;
+    double lastFrameTime = 0.0;
+    bool closeRequested = false;
+    bool iconified = false,
+         focused = true;
+    std::atomic<bool> redrawRequested = false;
+    // ImGui needs a couple of frames after an event to settle hover and
+    // layout, so input keeps the loop awake for this many frames.
+    int activeFrames = 0,
+        settleFrames = 3;
+    double backgroundTickRate = 15.0;
+    // Declared before the stack so states can unsubscribe on destruction.
+    EventBus events;
+    Subscription fullscreenSubscription;
+    std::unique_ptr<SettingsStore> settings;
     StateStack stateStack;
+    InputSystem input;
+    FixedTimestep fixedTimestep;
+    bool fixedTimestepEnabled = true;
+    FramePacer framePacer;
+    // Swap interval is per-context state, so it is requested here and set by
+    // whichever thread currently owns the context.
+    std::atomic<int> requestedSwapInterval = 1;
+    int appliedSwapInterval = 1;
     std::unique_ptr<ImGuiManager> imGuiManager;
+    SpriteBatch spriteBatch;
+    std::unique_ptr<SpriteRenderer> spriteRenderer;
+    int framebufferWidth = 800,
+        framebufferHeight = 600;
+    std::unique_ptr<TextureLoader> textureLoader;
+    std::unique_ptr<TextureCache> textureCache;
+    std::unique_ptr<JobSystem> jobSystem;
+    double textureUploadBudget = 0.002;
+    Profiler profiler;
+    std::unique_ptr<GpuProfiler> gpuProfiler;
+    std::unique_ptr<ProfilerOverlayState> profilerOverlay;
+    bool pipelinedRendering = false;
+    std::unique_ptr<RenderThread> renderThread;
 };
\ No newline at end of file
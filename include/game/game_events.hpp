@@ -0,0 +1,8 @@
+#pragma once
+
+// Events sent over Game's EventBus. Plain values, so they can be queued from
+// any thread.
+struct FullscreenToggled
+{
+    bool fullscreen;
+};
\ No newline at end of file
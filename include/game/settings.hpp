@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "game/frame_pacer.hpp"
+
+struct Settings
+{
+    bool fullscreen = false;
+    int windowWidth = 800,
+        windowHeight = 600;
+    PresentMode presentMode = PresentMode::Vsync;
+    double frameRateCap = FramePacer::defaultFrameRateCap;
+    bool lateLatch = false;
+
+    // INI text. Unknown keys and unreadable values keep their defaults, so a
+    // hand-edited file never stops the game from starting.
+    static Settings parse(std::string_view text);
+    std::string serialize() const;
+};
+
+// Owns the game's settings. States read them in place through get(), and
+// modify applies a change and hands a copy to a writer thread. The writer
+// waits writeDelay for more changes, then saves them all with one write to
+// a temporary file that replaces the real one. A file that cannot be read
+// is logged and leaves the defaults in place. A write that fails is logged
+// and the settings stay in memory; only flush reports it. With no file path
+// nothing is loaded or saved. get and modify belong to the main thread.
+class SettingsStore
+{
+public:
+    explicit SettingsStore(
+        std::string filePath = "",
+        std::chrono::milliseconds writeDelay = std::chrono::milliseconds(250));
+    ~SettingsStore();
+    SettingsStore(const SettingsStore &) = delete;
+    SettingsStore &operator=(const SettingsStore &) = delete;
+    const Settings &get() const;
+    void modify(const std::function<void(Settings &)> &change);
+    // Blocks until every change so far is on disk, and rethrows the error
+    // of a write that failed.
+    void flush();
+    const std::string &getFilePath() const;
+    size_t getWriteCount() const;
+    // settings.ini in the player's configuration directory, or in the
+    // working directory where the platform has none.
+    static std::string getDefaultPath();
+
+private:
+    void writerLoop();
+    void write(const Settings &snapshot);
+    void rethrowWriteError();
+
+    std::string filePath;
+    std::chrono::milliseconds writeDelay;
+    Settings settings;
+
+    // Shared with the writer.
+    mutable std::mutex mutex;
+    std::condition_variable changed,
+        written;
+    Settings pendingSettings;
+    uint64_t changeVersion = 0,
+             writtenVersion = 0;
+    size_t writeCount = 0;
+    std::exception_ptr writeError;
+    bool flushRequested = false,
+         stopping = false;
+    std::thread writer;
+};
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include "input/input_event.hpp"
 
 class Game;
 
@@ -13,7 +14,20 @@ public:
     virtual void onPause() {}
     virtual void onResume() {}
     virtual void update(float dt) {}
-    virtual void render() {}
+    virtual void render(float alpha) {}
+    // Input reaches the top state first; returning true stops it there.
+    virtual bool handleInput(const InputEvent &event) { return false; }
+    virtual bool isOpaque() const { return false; }
+    virtual bool updatesWhenCovered() const { return false; }
+    // Modal states keep every event away from the states below. Their UI is
+    // theirs to make modal, e.g. with an ImGui popup.
+    virtual bool blocksInput() const { return false; }
+    virtual bool isParallelUpdateSafe() const { return false; }
+    // States that only change in response to input return false; when no
+    // updating state needs continuous frames the game waits for events.
+    // Asked every frame, so a state can return true while it is dirty.
+    virtual bool needsContinuousUpdates() const { return true; }
+    virtual const char *getName() const { return "GameState"; }
 
 protected:
     Game *game = nullptr;
@@ -1,16 +1,53 @@
 #pragma once
+#include <array>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "game/asset_manifest.hpp"
 #include "game/states/game_state.hpp"
-#include "game/states/splash_state.hpp"
+#include "game/states/pooled_state.hpp"
 
-class LoadingState : public GameState
+class LoadingState : public GameState, public Pooled<LoadingState>
 {
 public:
-    LoadingState(Game &game)
-        : GameState(game)
+    using NextStateFactory = std::function<std::unique_ptr<GameState>(LoadedAssets)>;
+
+    LoadingState(Game &game, AssetManifest manifest, NextStateFactory makeNextState)
+        : GameState(game),
+          manifest(std::move(manifest)),
+          makeNextState(std::move(makeNextState))
     {
+        if (!this->makeNextState)
+            throw std::invalid_argument("LoadingState: makeNextState must not be empty");
+
         pickRandomQuote();
     }
 
+    const char *getName() const override
+    {
+        return "LoadingState";
+    }
+
+    void onEnter() override
+    {
+        TextureCache &textureCache = game->getTextureCache();
+
+        textures.clear();
+        for (const auto &asset : manifest.textures)
+            textures.push_back(textureCache.load(asset.filePath, asset.flipY));
+    }
+
+    void onExit() override
+    {
+        textures.clear();
+    }
+
+    bool isOpaque() const override
+    {
+        return true;
+    }
+
     void update(float deltaTime) override
     {
         quoteChangeTimer += deltaTime;
@@ -20,17 +57,46 @@ public:
             quoteChangeTimer = 0.0f;
         }
 
-        timer += deltaTime;
-        if (timer >= duration)
-            game->getStateStack().replace(std::make_unique<SplashState>(*game, 3.0f));
+        // Failed textures count as done: the next state gets their
+        // placeholder rather than a loading screen that never ends.
+        loadedCount = 0;
+        loadedBytes = 0;
+        totalBytes = 0;
+        sizesKnown = true;
+        for (const auto &texture : textures)
+        {
+            size_t fileSize = texture->getFileSize();
+            totalBytes += fileSize;
+
+            if (texture->isReady() || texture->hasFailed())
+            {
+                ++loadedCount;
+                loadedBytes += fileSize;
+            }
+            else if (fileSize == 0)
+            {
+                sizesKnown = false;
+            }
+        }
+
+        if (!finished && loadedCount == textures.size())
+        {
+            finished = true;
+
+            LoadedAssets assets;
+            for (size_t i = 0; i < textures.size(); ++i)
+                assets.addTexture(manifest.textures[i].name, textures[i]);
+
+            game->getStateStack().replace(makeNextState(std::move(assets)));
+        }
     }
 
-    void render() override
+    void render(float alpha) override
     {
-        ImGuiViewport *viewport = ImGui::GetMainViewport();
+        const UiLayout &layout = game->getImGuiManager().getLayout();
 
-        ImGui::SetNextWindowPos(viewport->Pos);
-        ImGui::SetNextWindowSize(viewport->Size);
+        ImGui::SetNextWindowPos(layout.position);
+        ImGui::SetNextWindowSize(layout.size);
 
         ImGuiWindowFlags window_flags =
             ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground |
@@ -39,34 +105,82 @@ public:
 
         ImGui::Begin("Loading", nullptr, window_flags);
 
-        std::string text = "Loading ...";
-        ImVec2 text_size = ImGui::CalcTextSize(text.c_str());
-        float text_x = (viewport->Size.x - text_size.x) * 0.5f;
-        float text_y = (viewport->Size.y - text_size.y) * 0.4f;
+        if (layout.generation != layoutGeneration)
+        {
+            layoutGeneration = layout.generation;
+            layoutQuote = nullptr;
+
+            ImVec2 text_size = ImGui::CalcTextSize(loadingText);
+            textPos = ImVec2((layout.size.x - text_size.x) * 0.5f, (layout.size.y - text_size.y) * 0.4f);
+            progressPos = ImVec2((layout.size.x - progressSize.x) * 0.5f, textPos.y + text_size.y + 20.0f);
+        }
+
+        ImGui::SetCursorPos(textPos);
+        ImGui::Text("%s", loadingText);
 
-        ImGui::SetCursorPos(ImVec2(text_x, text_y));
-        ImGui::Text("%s", text.c_str());
+        char progress_text[64];
+        std::snprintf(
+            progress_text, sizeof(progress_text),
+            "%zu / %zu assets (%.1f / %.1f MB)",
+            loadedCount, textures.size(),
+            loadedBytes / (1024.0 * 1024.0), totalBytes / (1024.0 * 1024.0));
 
-        if (!currentQuote.empty())
+        ImGui::SetCursorPos(progressPos);
+        ImGui::ProgressBar(getProgress(), progressSize, progress_text);
+
+        if (currentQuote)
         {
-            ImVec2 quote_size = ImGui::CalcTextSize(currentQuote.c_str());
-            float quote_x = (viewport->Size.x - quote_size.x) * 0.5f;
-            float quote_y = text_y + text_size.y + 20.0f;
+            // The quote changes every couple of seconds, so it is measured
+            // then rather than with the rest of the layout.
+            if (currentQuote != layoutQuote)
+            {
+                layoutQuote = currentQuote;
+                ImVec2 quote_size = ImGui::CalcTextSize(currentQuote);
+                quotePos = ImVec2(
+                    (layout.size.x - quote_size.x) * 0.5f,
+                    progressPos.y + ImGui::GetFrameHeight() + 20.0f);
+            }
 
-            ImGui::SetCursorPos(ImVec2(quote_x, quote_y));
-            ImGui::Text("%s", currentQuote.c_str());
+            ImGui::SetCursorPos(quotePos);
+            ImGui::Text("%s", currentQuote);
         }
 
         ImGui::End();
     }
 
+    float getProgress() const
+    {
+        if (textures.empty())
+            return 1.0f;
+        // Sizes arrive as the workers stat the files; until they all have,
+        // a byte ratio would jump backwards.
+        if (sizesKnown && totalBytes > 0)
+            return static_cast<float>(static_cast<double>(loadedBytes) / totalBytes);
+
+        return static_cast<float>(loadedCount) / textures.size();
+    }
+
 private:
-    float duration = 4.0f,
-          timer = 0.0f,
-          quoteChangeTimer = 0.0f,
+    AssetManifest manifest;
+    NextStateFactory makeNextState;
+    std::vector<std::shared_ptr<TextureHandle>> textures;
+    size_t loadedCount = 0,
+           loadedBytes = 0,
+           totalBytes = 0;
+    bool sizesKnown = false;
+    bool finished = false;
+    float quoteChangeTimer = 0.0f,
           quoteChangeDuration = 2.0f;
-    std::string currentQuote;
-    std::vector<std::string> quotes = {
+    const char *currentQuote = nullptr,
+               *layoutQuote = nullptr;
+    static constexpr const char *loadingText = "Loading ...";
+    ImVec2 progressSize = ImVec2(300.0f, 0.0f),
+           textPos,
+           progressPos,
+           quotePos;
+    uint64_t layoutGeneration = 0;
+
+    static constexpr std::array<const char *, 10> quotes = {
         "Finding the number of grains of sand on the beach.",
         "Digging a hole to the other side of the world.",
         "Counting how many crabs run sideways.",
@@ -80,10 +194,6 @@ private:
 
     void pickRandomQuote()
     {
-        if (!quotes.empty())
-        {
-            int index = rand() % quotes.size();
-            currentQuote = quotes[index];
-        }
+        currentQuote = quotes[rand() % quotes.size()];
     }
 };
\ No newline at end of file
@@ -1,16 +1,45 @@
 #pragma once
-#include <signals.hpp>
+#include "game/frame_pacer.hpp"
+#include "game/game_events.hpp"
+#include "game/settings.hpp"
 #include "game/states/game_state.hpp"
+#include "game/states/pooled_state.hpp"
 
 
-class OptionsState : public GameState
+class OptionsState : public GameState, public Pooled<OptionsState>
 {
 public:
     OptionsState(Game &game)
-        : GameState(game)
+        : GameState(game),
+          fullscreen(game.getSettings().get().fullscreen),
+          wasFullscreen(fullscreen)
     {
     }
 
+    const char *getName() const override
+    {
+        return "OptionsState";
+    }
+
+    bool needsContinuousUpdates() const override
+    {
+        return false;
+    }
+
+    bool blocksInput() const override
+    {
+        return true;
+    }
+
+    bool handleInput(const InputEvent &event) override
+    {
+        if (!event.isKeyPress(InputKey::Escape))
+            return false;
+
+        open = false;
+        return true;
+    }
+
     void update(float dt) override
     {
         if (!open)
@@ -19,35 +48,92 @@ public:
         if (fullscreen != wasFullscreen)
         {
             wasFullscreen = fullscreen;
-            onFullscreenToggled(fullscreen);
+            game->getSettings().modify([this](Settings &settings)
+                                       { settings.fullscreen = fullscreen; });
+            game->getEvents().enqueue(FullscreenToggled{fullscreen});
         }
     }
 
-    void render() override
+    void render(float alpha) override
     {
-        ImGuiViewport *viewport = ImGui::GetMainViewport();
+        const UiLayout &layout = game->getImGuiManager().getLayout();
+        if (layout.generation != layoutGeneration)
+        {
+            layoutGeneration = layout.generation;
+            windowPos = layout.getCenteredPosition(windowSize);
+            windowPos.x += 200;
+        }
 
-        ImVec2 window_size(200, 200);
-        ImVec2 window_pos(
-            viewport->Pos.x + (viewport->Size.x - window_size.x) * 0.5f + 200,
-            viewport->Pos.y + (viewport->Size.y - window_size.y) * 0.5f);
+        // A modal popup dims the UI below and keeps it from being clicked.
+        if (!ImGui::IsPopupOpen("Options"))
+            ImGui::OpenPopup("Options");
 
-        ImGui::SetNextWindowPos(window_pos);
-        ImGui::SetNextWindowSize(window_size);
+        ImGui::SetNextWindowPos(windowPos);
+        ImGui::SetNextWindowSize(windowSize);
 
-        ImGui::Begin(
-            "Options", &open,
-            ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollWithMouse |
-                ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoBringToFrontOnFocus);
+        if (!ImGui::BeginPopupModal(
+                "Options", &open,
+                ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollWithMouse |
+                    ImGuiWindowFlags_NoSavedSettings))
+            return;
 
         ImGui::Checkbox("Fullscreen", &fullscreen);
 
-        ImGui::End();
-    }
+        if (renderFramePacing(game->getFramePacer()))
+            saveFramePacing(game->getFramePacer());
 
-    fteng::signal<void(bool)> onFullscreenToggled;
+        ImGui::EndPopup();
+    }
 
 private:
+    // Returns whether anything changed.
+    bool renderFramePacing(FramePacer &framePacer)
+    {
+        static constexpr const char *presentModeNames[] = {"Vsync", "Adaptive vsync", "Uncapped", "Capped"};
+        bool changed = false;
+
+        int presentMode = static_cast<int>(framePacer.getMode());
+        if (ImGui::Combo("Present", &presentMode, presentModeNames, IM_ARRAYSIZE(presentModeNames)))
+        {
+            framePacer.setMode(static_cast<PresentMode>(presentMode));
+            changed = true;
+        }
+
+        if (framePacer.getMode() == PresentMode::Capped)
+        {
+            float frameRateCap = static_cast<float>(framePacer.getFrameRateCap());
+            if (ImGui::SliderFloat("FPS cap", &frameRateCap, 30.0f, 240.0f, "%.0f"))
+            {
+                framePacer.setFrameRateCap(frameRateCap);
+                changed = true;
+            }
+        }
+
+        bool lateLatch = framePacer.isLateLatchEnabled();
+        if (ImGui::Checkbox("Late latch input", &lateLatch))
+        {
+            framePacer.setLateLatchEnabled(lateLatch);
+            changed = true;
+        }
+
+        const FramePacingStats &stats = framePacer.getStats();
+        ImGui::Text("Missed %zu of %zu frames", stats.missedDeadlines, stats.frameCount);
+        ImGui::Text("Frame %.2f ms, work %.2f ms", stats.lastFrameTime * 1000.0, stats.lastWorkTime * 1000.0);
+        return changed;
+    }
+
+    void saveFramePacing(const FramePacer &framePacer)
+    {
+        game->getSettings().modify([&framePacer](Settings &settings)
+                                   {
+                                       settings.presentMode = framePacer.getMode();
+                                       settings.frameRateCap = framePacer.getFrameRateCap();
+                                       settings.lateLatch = framePacer.isLateLatchEnabled(); });
+    }
+
+    ImVec2 windowSize = ImVec2(260, 200),
+           windowPos;
+    uint64_t layoutGeneration = 0;
     bool fullscreen = false,
          wasFullscreen = false,
          open = true;
@@ -1,8 +1,9 @@
 #pragma once
 #include "game/states/game_state.hpp"
+#include "game/states/pooled_state.hpp"
 #include "game/states/options_state.hpp"
 
-class PlayState : public GameState
+class PlayState : public GameState, public Pooled<PlayState>
 {
 public:
     PlayState(Game &game)
@@ -10,14 +11,31 @@ public:
     {
     }
 
-    void onPause() override
+    const char *getName() const override
     {
-        paused = true;
+        return "PlayState";
     }
 
-    void onResume() override
+    bool needsContinuousUpdates() const override
     {
-        paused = false;
+        return false;
+    }
+
+    bool isOpaque() const override
+    {
+        return true;
+    }
+
+    bool handleInput(const InputEvent &event) override
+    {
+        if (event.isKeyPress(InputKey::Space))
+            addScore = true;
+        else if (event.isKeyPress(InputKey::Escape))
+            transition = true;
+        else
+            return false;
+
+        return true;
     }
 
     void update(float dt) override
@@ -35,17 +53,17 @@ public:
         }
     }
 
-    void render() override
+    void render(float alpha) override
     {
-        ImGuiViewport *viewport = ImGui::GetMainViewport();
-
-        ImVec2 window_size(200, 200);
-        ImVec2 window_pos(
-            viewport->Pos.x + (viewport->Size.x - window_size.x) * 0.5f,
-            viewport->Pos.y + (viewport->Size.y - window_size.y) * 0.5f);
+        const UiLayout &layout = game->getImGuiManager().getLayout();
+        if (layout.generation != layoutGeneration)
+        {
+            layoutGeneration = layout.generation;
+            windowPos = layout.getCenteredPosition(windowSize);
+        }
 
-        ImGui::SetNextWindowPos(window_pos);
-        ImGui::SetNextWindowSize(window_size);
+        ImGui::SetNextWindowPos(windowPos);
+        ImGui::SetNextWindowSize(windowSize);
 
         ImGui::Begin(
             "Play", nullptr,
@@ -57,22 +75,20 @@ public:
 
         ImGui::Text("Score: %d", score);
 
-        ImGui::BeginDisabled(paused);
-
         if (ImGui::Button("Press Me!"))
             addScore = true;
 
         if (ImGui::Button("Options"))
             transition = true;
 
-        ImGui::EndDisabled();
-
         ImGui::End();
     }
 
 private:
+    ImVec2 windowSize = ImVec2(200, 200),
+           windowPos;
+    uint64_t layoutGeneration = 0;
     int score = 0;
     bool transition = false,
-         addScore = false,
-         paused = false;
+         addScore = false;
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include "core/block_pool.hpp"
+
+// Gives a state type its own BlockPool: derive State from Pooled<State> and
+// every make_unique<State> / StateStack pop reuses the same few slots instead
+// of going to the heap. Classes derived further from State are a different
+// size and fall back to the global allocator.
+template <typename State>
+class Pooled
+{
+public:
+    static void *operator new(size_t size)
+    {
+        if (size != sizeof(State))
+            return ::operator new(size);
+
+        return getPool().allocate();
+    }
+
+    static void operator delete(void *pointer, size_t size)
+    {
+        if (size != sizeof(State))
+        {
+            ::operator delete(pointer);
+            return;
+        }
+
+        getPool().deallocate(pointer);
+    }
+
+    static BlockPool &getPool()
+    {
+        static BlockPool pool(sizeof(State), alignof(State), 2);
+        return pool;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+#include <imgui.h>
+#include <initializer_list>
+#include <vector>
+#include "core/profiler.hpp"
+#include "rendering/ui/imgui_manager.hpp"
+#include "game/states/game_state.hpp"
+
+class ProfilerOverlayState : public GameState
+{
+public:
+    ProfilerOverlayState(Game &game, const Profiler &profiler, const ImGuiManager &imGuiManager)
+        : GameState(game),
+          profiler(profiler),
+          imGuiManager(imGuiManager)
+    {
+    }
+
+    const char *getName() const override
+    {
+        return "ProfilerOverlayState";
+    }
+
+    void update(float dt) override
+    {
+        // Sorting every section's history is cheap but not free, and numbers
+        // changing every frame are unreadable anyway.
+        refreshTimer -= dt;
+        if (refreshTimer > 0.0f)
+            return;
+
+        refreshTimer = refreshInterval;
+        stats = profiler.getStats();
+    }
+
+    void render(float alpha) override
+    {
+        const UiLayout &layout = imGuiManager.getLayout();
+        ImGui::SetNextWindowPos(ImVec2(layout.position.x + 10, layout.position.y + 10));
+        ImGui::SetNextWindowBgAlpha(0.75f);
+
+        ImGui::Begin(
+            "Profiler", nullptr,
+            ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+                ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove);
+
+        ImGui::Text("ms over the last %zu frames (F3 to hide)", profiler.getHistorySize());
+
+        if (ImGui::BeginTable("ProfilerSections", 7, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("Section");
+            ImGui::TableSetupColumn("CPU p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("GPU p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableHeadersRow();
+
+            for (const auto &section : stats)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(section.label.c_str());
+                renderTimingColumns(section.cpu);
+                renderTimingColumns(section.gpu);
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+
+private:
+    void renderTimingColumns(const TimingStats &timing)
+    {
+        for (double value : {timing.p50, timing.p95, timing.p99})
+        {
+            ImGui::TableNextColumn();
+            if (timing.sampleCount == 0)
+                ImGui::TextUnformatted("-");
+            else
+                ImGui::Text("%.3f", value * 1000.0);
+        }
+    }
+
+    const Profiler &profiler;
+    const ImGuiManager &imGuiManager;
+    std::vector<ProfileStats> stats;
+    float refreshTimer = 0.0f,
+          refreshInterval = 0.25f;
+};
\ No newline at end of file
@@ -1,21 +1,31 @@
 #pragma once
 #include <memory>
-#include <rendering/texture2d.hpp>
+#include "rendering/texture_loader.hpp"
 #include "game/states/game_state.hpp"
+#include "game/states/pooled_state.hpp"
 #include "game/states/play_state.hpp"
 
-class SplashState : public GameState
+class SplashState : public GameState, public Pooled<SplashState>
 {
 public:
-    SplashState(Game &game, float duration)
+    SplashState(Game &game, float duration, std::shared_ptr<TextureHandle> splashTexture)
         : GameState(game),
-          duration(duration)
+          duration(duration),
+          splashTexture(std::move(splashTexture))
     {
+        if (!this->splashTexture)
+            throw std::invalid_argument("SplashState: splashTexture must not be nullptr");
     }
 
-    void onEnter() override
+    const char *getName() const override
     {
-        splashTexture = std::make_unique<Texture2D>("../../assets/textures/man_on_a_beach_logo.jpg");
+        return "SplashState";
+    }
+
+    // A still image; ending a few ticks late at the idle rate is fine.
+    bool needsContinuousUpdates() const override
+    {
+        return false;
     }
 
     void onExit() override
@@ -23,6 +33,11 @@ public:
         splashTexture.reset();
     }
 
+    bool isOpaque() const override
+    {
+        return true;
+    }
+
     void update(float deltaTime) override
     {
         timer += deltaTime;
@@ -30,12 +45,12 @@ public:
             game->getStateStack().replace(std::make_unique<PlayState>(*game));
     }
 
-    void render() override
+    void render(float alpha) override
     {
-        ImGuiViewport *viewport = ImGui::GetMainViewport();
+        const UiLayout &layout = game->getImGuiManager().getLayout();
 
-        ImGui::SetNextWindowPos(viewport->Pos);
-        ImGui::SetNextWindowSize(viewport->Size);
+        ImGui::SetNextWindowPos(layout.position);
+        ImGui::SetNextWindowSize(layout.size);
 
         ImGuiWindowFlags window_flags =
             ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground |
@@ -44,32 +59,35 @@ public:
 
         ImGui::Begin("Splash", nullptr, window_flags);
 
-        ImVec2 image_size(400, 400);
-
-        ImVec2 image_pos(
-            viewport->Pos.x + (viewport->Size.x - image_size.x) * 0.5f,
-            viewport->Pos.y + (viewport->Size.y - image_size.y) * 0.5f);
-
-        ImGui::GetWindowDrawList()->AddImage(
-            (ImTextureID)(intptr_t)splashTexture->getTextureID(),
-            image_pos,
-            ImVec2(image_pos.x + image_size.x,
-                   image_pos.y + image_size.y));
+        if (layout.generation != layoutGeneration)
+        {
+            layoutGeneration = layout.generation;
+            imagePos = layout.getCenteredPosition(imageSize);
 
-        const char *text = "Man on a beach presents";
-        ImVec2 text_size = ImGui::CalcTextSize(text);
+            ImVec2 text_size = ImGui::CalcTextSize(text);
+            textPos = ImVec2(
+                (layout.size.x - text_size.x) * 0.5f,
+                layout.size.y - text_size.y - 50);
+        }
 
-        float text_x = (viewport->Size.x - text_size.x) * 0.5f;
-        float text_y = viewport->Size.y - text_size.y - 50;
+        game->getSpriteBatch().draw(
+            splashTexture->getTextureID(),
+            glm::vec2(imagePos.x, imagePos.y),
+            glm::vec2(imageSize.x, imageSize.y));
 
-        ImGui::SetCursorPos(ImVec2(text_x, text_y));
+        ImGui::SetCursorPos(textPos);
         ImGui::Text("%s", text);
 
         ImGui::End();
     }
 
 private:
+    static constexpr const char *text = "Man on a beach presents";
+    ImVec2 imageSize = ImVec2(400, 400),
+           imagePos,
+           textPos;
+    uint64_t layoutGeneration = 0;
     float duration,
         timer = 0.0f;
-    std::unique_ptr<Texture2D> splashTexture;
+    std::shared_ptr<TextureHandle> splashTexture;
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// The transition rules shared by StateStack and VariantStateStack, so the
+// two cannot drift apart.
+
+enum class StackAction
+{
+    Push,
+    Pop,
+    Replace
+};
+
+namespace StackTransitions
+{
+    // A queued state is either the element itself or, where elements cannot
+    // be empty, an optional one that a pop leaves unset.
+    template <typename Element>
+    Element &&take(Element &state)
+    {
+        return std::move(state);
+    }
+
+    template <typename Element>
+    Element &&take(std::optional<Element> &state)
+    {
+        return std::move(*state);
+    }
+
+    // Folds the queue into "pop N existing states, then push these new ones".
+    // A pop that follows a pending push cancels it, so the pushed state is
+    // destroyed without ever seeing onEnter/onExit. Hooks provides static
+    // enter, exit, pause and resume for an element.
+    template <typename Hooks, typename Element, typename Change>
+    void apply(std::vector<Element> &stack, std::vector<Change> &changes, std::vector<Element> &pushes)
+    {
+        size_t pops = 0;
+        pushes.clear();
+        for (auto &change : changes)
+        {
+            if (change.action != StackAction::Push)
+            {
+                if (!pushes.empty())
+                    pushes.pop_back();
+                else
+                    ++pops;
+            }
+
+            if (change.action != StackAction::Pop)
+                pushes.push_back(take(change.state));
+        }
+        pops = std::min(pops, stack.size());
+
+        for (size_t i = 0; i < pops; ++i)
+        {
+            Hooks::exit(stack.back());
+            stack.pop_back();
+        }
+
+        if (pushes.empty())
+        {
+            if (pops > 0 && !stack.empty())
+                Hooks::resume(stack.back());
+            return;
+        }
+
+        // A state uncovered by this batch and immediately covered again is
+        // still paused, so it gets neither onResume nor a second onPause.
+        if (pops == 0 && !stack.empty())
+            Hooks::pause(stack.back());
+
+        for (size_t i = 0; i < pushes.size(); ++i)
+        {
+            if (i > 0)
+                Hooks::pause(stack.back());
+
+            stack.push_back(std::move(pushes[i]));
+            Hooks::enter(stack.back());
+        }
+        pushes.clear();
+    }
+
+    // Index of the topmost element matching predicate, or 0 when none does.
+    template <typename Element, typename Predicate>
+    size_t findTopmost(const std::vector<Element> &stack, Predicate predicate)
+    {
+        for (size_t i = stack.size(); i > 0; --i)
+        {
+            if (predicate(stack[i - 1]))
+                return i - 1;
+        }
+        return 0;
+    }
+}
\ No newline at end of file
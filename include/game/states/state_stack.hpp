@@ -1,8 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "game/states/game_state.hpp"
+#include "game/states/stack_transitions.hpp"
+#include "input/input_event.hpp"
+
+class JobSystem;
+class Profiler;
 
 class StateStack
 {
@@ -10,12 +16,41 @@ public:
     void push(std::unique_ptr<GameState> state);
     void pop();
     void replace(std::unique_ptr<GameState> state);
+    // Pops every state, including ones still waiting to be pushed.
+    void clear();
     void update(float deltaTime);
-    void render();
+    void render(float alpha = 1.0f);
+    bool handleInput(const InputEvent &event);
+    void applyPendingChanges();
+    bool hasPendingChanges() const;
     bool isEmpty() const;
     size_t size() const;
     GameState &top() const;
+    bool needsContinuousUpdates() const;
+    void setProfiler(Profiler *profiler);
+    void setJobSystem(JobSystem *jobSystem);
 
 private:
+    using Action = StackAction;
+
+    struct PendingChange
+    {
+        Action action;
+        std::unique_ptr<GameState> state;
+    };
+
+    void requestChange(Action action, std::unique_ptr<GameState> state);
+    void updateSerially(float deltaTime);
+    void refreshCoverage();
+
     std::vector<std::unique_ptr<GameState>> stack;
+    std::vector<PendingChange> pendingChanges, applyingChanges;
+    std::vector<std::unique_ptr<GameState>> pushes;
+    std::vector<GameState *> serialUpdates, parallelUpdates;
+    mutable std::mutex pendingMutex;
+    size_t firstVisible = 0,
+           firstInputReceiver = 0;
+    int dispatchDepth = 0;
+    Profiler *profiler = nullptr;
+    JobSystem *jobSystem = nullptr;
 };
\ No newline at end of file
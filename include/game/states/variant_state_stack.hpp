@@ -0,0 +1,234 @@
+#pragma once
+#include <concepts>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "game/states/stack_transitions.hpp"
+
+// Compile-time alternative to StateStack for a closed set of state types.
+// States are stored inline in one contiguous vector and every hook is a
+// direct, inlinable call instead of a virtual one. A state only declares the
+// hooks it needs; GameState subclasses work too and are called non-virtually.
+// Pushes, pops and replaces are applied by the same rules as in StateStack,
+// but there is no input dispatch, no continuous update tracking and no
+// parallel update. States must be movable, and references into the stack
+// are invalidated by transitions.
+template <typename... States>
+class VariantStateStack
+{
+public:
+    using State = std::variant<States...>;
+
+    template <typename S, typename... Args>
+    void push(Args &&...args)
+    {
+        requestChange(Action::Push, State(std::in_place_type<S>, std::forward<Args>(args)...));
+    }
+
+    void pop()
+    {
+        requestChange(Action::Pop, std::nullopt);
+    }
+
+    template <typename S, typename... Args>
+    void replace(Args &&...args)
+    {
+        requestChange(Action::Replace, State(std::in_place_type<S>, std::forward<Args>(args)...));
+    }
+
+    void update(float deltaTime)
+    {
+        {
+            DispatchScope scope(dispatchDepth);
+            for (size_t index : coveredUpdates)
+                updateState(stack[index], deltaTime);
+
+            if (!stack.empty())
+                updateState(stack.back(), deltaTime);
+        }
+
+        applyPendingChanges();
+    }
+
+    void render(float alpha = 1.0f)
+    {
+        {
+            DispatchScope scope(dispatchDepth);
+            for (size_t i = firstVisible; i < stack.size(); ++i)
+                renderState(stack[i], alpha);
+        }
+
+        applyPendingChanges();
+    }
+
+    void applyPendingChanges()
+    {
+        if (dispatchDepth > 0 || pendingChanges.empty())
+            return;
+
+        DispatchScope scope(dispatchDepth);
+        while (!pendingChanges.empty())
+        {
+            applyingChanges.clear();
+            applyingChanges.swap(pendingChanges);
+            StackTransitions::apply<Hooks>(stack, applyingChanges, pushes);
+        }
+        applyingChanges.clear();
+
+        refreshCoverage();
+    }
+
+    bool hasPendingChanges() const
+    {
+        return !pendingChanges.empty();
+    }
+
+    bool isEmpty() const
+    {
+        return stack.empty();
+    }
+
+    size_t size() const
+    {
+        return stack.size();
+    }
+
+    State &top()
+    {
+        if (stack.empty())
+            throw std::runtime_error("VariantStateStack: top called on empty stack");
+
+        return stack.back();
+    }
+
+private:
+    using Action = StackAction;
+
+    struct PendingChange
+    {
+        Action action;
+        std::optional<State> state;
+    };
+
+    struct DispatchScope
+    {
+        explicit DispatchScope(int &depth) : depth(depth) { ++depth; }
+        ~DispatchScope() { --depth; }
+
+        int &depth;
+    };
+
+    // Qualified calls (state.S::hook()) bind statically even when S derives
+    // from GameState, which is what keeps these loops free of indirection.
+    static void enterState(State &state)
+    {
+        std::visit([](auto &s)
+                   {
+            using S = std::remove_reference_t<decltype(s)>;
+            if constexpr (requires { s.S::onEnter(); })
+                s.S::onEnter(); }, state);
+    }
+
+    static void exitState(State &state)
+    {
+        std::visit([](auto &s)
+                   {
+            using S = std::remove_reference_t<decltype(s)>;
+            if constexpr (requires { s.S::onExit(); })
+                s.S::onExit(); }, state);
+    }
+
+    static void pauseState(State &state)
+    {
+        std::visit([](auto &s)
+                   {
+            using S = std::remove_reference_t<decltype(s)>;
+            if constexpr (requires { s.S::onPause(); })
+                s.S::onPause(); }, state);
+    }
+
+    static void resumeState(State &state)
+    {
+        std::visit([](auto &s)
+                   {
+            using S = std::remove_reference_t<decltype(s)>;
+            if constexpr (requires { s.S::onResume(); })
+                s.S::onResume(); }, state);
+    }
+
+    static void updateState(State &state, float deltaTime)
+    {
+        std::visit([deltaTime](auto &s)
+                   {
+            using S = std::remove_reference_t<decltype(s)>;
+            if constexpr (requires { s.S::update(deltaTime); })
+                s.S::update(deltaTime); }, state);
+    }
+
+    static void renderState(State &state, float alpha)
+    {
+        std::visit([alpha](auto &s)
+                   {
+            using S = std::remove_reference_t<decltype(s)>;
+            if constexpr (requires { s.S::render(alpha); })
+                s.S::render(alpha); }, state);
+    }
+
+    static bool isOpaque(const State &state)
+    {
+        return std::visit([](const auto &s)
+                          {
+            using S = std::remove_cvref_t<decltype(s)>;
+            if constexpr (requires { { s.S::isOpaque() } -> std::convertible_to<bool>; })
+                return static_cast<bool>(s.S::isOpaque());
+            else
+                return false; }, state);
+    }
+
+    static bool updatesWhenCovered(const State &state)
+    {
+        return std::visit([](const auto &s)
+                          {
+            using S = std::remove_cvref_t<decltype(s)>;
+            if constexpr (requires { { s.S::updatesWhenCovered() } -> std::convertible_to<bool>; })
+                return static_cast<bool>(s.S::updatesWhenCovered());
+            else
+                return false; }, state);
+    }
+
+    struct Hooks
+    {
+        static void enter(State &state) { enterState(state); }
+        static void exit(State &state) { exitState(state); }
+        static void pause(State &state) { pauseState(state); }
+        static void resume(State &state) { resumeState(state); }
+    };
+
+    void requestChange(Action action, std::optional<State> state)
+    {
+        pendingChanges.push_back({action, std::move(state)});
+        applyPendingChanges();
+    }
+
+    void refreshCoverage()
+    {
+        firstVisible = StackTransitions::findTopmost(stack, isOpaque);
+
+        coveredUpdates.clear();
+        for (size_t i = 0; i + 1 < stack.size(); ++i)
+        {
+            if (updatesWhenCovered(stack[i]))
+                coveredUpdates.push_back(i);
+        }
+    }
+
+    std::vector<State> stack;
+    std::vector<PendingChange> pendingChanges, applyingChanges;
+    std::vector<State> pushes;
+    std::vector<size_t> coveredUpdates;
+    size_t firstVisible = 0;
+    int dispatchDepth = 0;
+};
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+
+enum class InputEventType : uint8_t
+{
+    Key,
+    MouseButton,
+    CursorMove,
+    Scroll,
+    GamepadButton,
+    GamepadAxis
+};
+
+// Same values as GLFW_RELEASE, GLFW_PRESS and GLFW_REPEAT.
+enum class InputAction : uint8_t
+{
+    Release = 0,
+    Press = 1,
+    Repeat = 2
+};
+
+// Codes are GLFW's own (GLFW_KEY_*, GLFW_MOUSE_BUTTON_*, GLFW_GAMEPAD_*).
+// The keys the game itself uses are mirrored here so states need not pull in
+// GLFW; input_system.cpp checks that they match.
+namespace InputKey
+{
+    constexpr int Space = 32,
+                  Escape = 256,
+                  F3 = 292;
+}
+
+struct InputEvent
+{
+    InputEventType type = InputEventType::Key;
+    InputAction action = InputAction::Press;
+    // Key, mouse button, gamepad button or gamepad axis.
+    int code = 0,
+        mods = 0,
+        gamepad = 0;
+    // Cursor position, scroll offset, or the axis value in x.
+    float x = 0.0f,
+          y = 0.0f;
+    // glfwGetTime() when the event was captured.
+    double time = 0.0;
+
+    bool isKeyPress(int key) const
+    {
+        return type == InputEventType::Key && code == key && action == InputAction::Press;
+    }
+};
\ No newline at end of file
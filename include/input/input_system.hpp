@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include "core/spsc_ring.hpp"
+#include "input/input_event.hpp"
+
+// Buffers timestamped input between the thread that captures it (GLFW
+// callbacks, gamepad polling) and the one that routes it to states. Events
+// that arrive while the ring is full are dropped and counted.
+class InputSystem
+{
+public:
+    explicit InputSystem(size_t capacity = 1024);
+    void push(const InputEvent &event);
+    // GLFW has no gamepad callbacks, so state changes since the last poll
+    // are turned into events here.
+    void pollGamepads(double time);
+    bool pop(InputEvent &event);
+    size_t getPendingCount() const;
+    size_t getDroppedCount() const;
+
+    // GLFW_JOYSTICK_LAST + 1, GLFW_GAMEPAD_BUTTON_LAST + 1 and
+    // GLFW_GAMEPAD_AXIS_LAST + 1.
+    static constexpr size_t maxGamepads = 16,
+                            gamepadButtonCount = 15,
+                            gamepadAxisCount = 6;
+
+private:
+    struct GamepadState
+    {
+        bool connected = false;
+        std::array<unsigned char, gamepadButtonCount> buttons{};
+        std::array<float, gamepadAxisCount> axes{};
+    };
+
+    SpscRing<InputEvent> events;
+    std::atomic<size_t> droppedCount = 0;
+    std::array<GamepadState, maxGamepads> gamepads{};
+};
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+struct AtlasSource
+{
+    std::string name;
+    int width = 0, height = 0;
+    const unsigned char *rgbaPixels = nullptr;
+};
+
+struct UVRect
+{
+    glm::vec2 min, max;
+};
+
+// The CPU half of TextureAtlas: packs the sources into RGBA pages and keeps
+// the UV table. Needs no GL context, so it can be built and checked on its
+// own.
+class AtlasLayout
+{
+public:
+    AtlasLayout(const std::vector<AtlasSource> &sources, int pageSize = 2048, int padding = 1);
+    uint32_t getFrameIndex(const std::string &name) const;
+    size_t getFrameCount() const;
+    const UVRect &getUV(uint32_t frame) const;
+    uint16_t getPage(uint32_t frame) const;
+    void getUVs(std::span<const uint32_t> frames, std::span<UVRect> uvs) const;
+    int getPageSize() const;
+    size_t getPageCount() const;
+    // Empty once releasePixels has been called.
+    std::span<const unsigned char> getPagePixels(size_t page) const;
+    // Frees the page pixels once they are uploaded; the UV table stays.
+    void releasePixels();
+
+private:
+    int pageSize;
+    std::vector<UVRect> uvRects;
+    std::vector<uint16_t> framePages;
+    std::vector<std::vector<unsigned char>> pagePixels;
+    std::unordered_map<std::string, uint32_t> frameIndices;
+};
\ No newline at end of file
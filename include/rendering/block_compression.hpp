@@ -0,0 +1,12 @@
+#pragma once
+#include <vector>
+
+void encodeBC1Block(const unsigned char *rgbaBlock, unsigned char *output);
+void encodeBC3Block(const unsigned char *rgbaBlock, unsigned char *output);
+void decodeBC1Block(const unsigned char *input, unsigned char *rgbaBlock);
+void decodeBC3Block(const unsigned char *input, unsigned char *rgbaBlock);
+std::vector<unsigned char> compressBC1(int width, int height, const unsigned char *rgbaPixels);
+std::vector<unsigned char> compressBC3(int width, int height, const unsigned char *rgbaPixels);
+std::vector<unsigned char> decompressBC1(int width, int height, const unsigned char *blocks);
+std::vector<unsigned char> decompressBC3(int width, int height, const unsigned char *blocks);
+size_t getBlockCompressedSize(int width, int height, size_t bytesPerBlock);
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/mapped_file.hpp"
+
+enum class CookedTextureFormat : uint32_t
+{
+    RGBA8 = 0,
+    BC1 = 1,
+    BC3 = 2
+};
+
+// On-disk layout, little-endian: one header, mipCount mip headers, then
+// the mip payloads at the offsets the mip headers give.
+struct CookedTextureHeader
+{
+    static constexpr uint32_t Magic = 0x58455447; // "GTEX"
+    static constexpr uint32_t Version = 1;
+
+    uint32_t magic = Magic,
+             version = Version,
+             format = 0,
+             width = 0,
+             height = 0,
+             mipCount = 0;
+};
+
+struct CookedMipHeader
+{
+    uint32_t width = 0,
+             height = 0;
+    uint64_t offset = 0,
+             byteSize = 0;
+};
+
+struct CookedMip
+{
+    int width = 0, height = 0;
+    const unsigned char *data = nullptr;
+    size_t byteSize = 0;
+};
+
+class CookedTexture
+{
+public:
+    explicit CookedTexture(const std::string &filePath);
+    explicit CookedTexture(std::vector<unsigned char> bytes);
+    static std::vector<unsigned char> cook(
+        int width, int height, const unsigned char *rgbaPixels,
+        CookedTextureFormat format, bool generateMips);
+    static bool isCookedPath(const std::string &filePath);
+    static size_t getMipByteSize(CookedTextureFormat format, int width, int height);
+    CookedTextureFormat getFormat() const;
+    int getWidth() const;
+    int getHeight() const;
+    size_t getMipCount() const;
+    const CookedMip &getMip(size_t level) const;
+    void prefault() const;
+
+private:
+    void parse(const unsigned char *bytes, size_t byteSize);
+
+    MappedFile file;
+    std::vector<unsigned char> ownedBytes;
+    CookedTextureFormat format = CookedTextureFormat::RGBA8;
+    std::vector<CookedMip> mips;
+};
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+#include "core/profiler.hpp"
+
+// Feeds GPU time per section into a Profiler using GL_TIMESTAMP queries.
+// Results are read back frameLatency frames later, so nothing ever waits on
+// the GPU; a frame whose queries are still in flight is simply dropped.
+class GpuProfiler
+{
+public:
+    explicit GpuProfiler(Profiler &profiler, size_t frameLatency = 4, size_t maxQueriesPerFrame = 128);
+    ~GpuProfiler();
+    GpuProfiler(const GpuProfiler &) = delete;
+    GpuProfiler &operator=(const GpuProfiler &) = delete;
+    void beginFrame();
+    bool isEnabled() const;
+    size_t timestamp();
+    void addRange(const char *name, const char *detail, size_t beginQuery, size_t endQuery);
+    size_t getDroppedFrameCount() const;
+
+    static constexpr size_t invalidQuery = static_cast<size_t>(-1);
+
+private:
+    struct Range
+    {
+        const char *name;
+        const char *detail;
+        size_t beginQuery, endQuery;
+    };
+
+    struct Frame
+    {
+        std::vector<GLuint> queries;
+        std::vector<Range> ranges;
+        size_t usedQueries = 0;
+    };
+
+    void collect(Frame &frame);
+
+    Profiler &profiler;
+    std::vector<Frame> frames;
+    size_t currentFrame = 0,
+           droppedFrames = 0;
+};
+
+class GpuProfileScope
+{
+public:
+    GpuProfileScope(GpuProfiler *gpuProfiler, const char *name, const char *detail = nullptr)
+        : gpuProfiler(gpuProfiler && gpuProfiler->isEnabled() ? gpuProfiler : nullptr),
+          name(name),
+          detail(detail)
+    {
+        if (this->gpuProfiler)
+            beginQuery = this->gpuProfiler->timestamp();
+    }
+
+    ~GpuProfileScope()
+    {
+        if (gpuProfiler)
+            gpuProfiler->addRange(name, detail, beginQuery, gpuProfiler->timestamp());
+    }
+
+    GpuProfileScope(const GpuProfileScope &) = delete;
+    GpuProfileScope &operator=(const GpuProfileScope &) = delete;
+
+private:
+    GpuProfiler *gpuProfiler;
+    const char *name,
+        *detail;
+    size_t beginQuery = GpuProfiler::invalidQuery;
+};
\ No newline at end of file
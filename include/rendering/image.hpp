@@ -0,0 +1,23 @@
+#pragma once
+#include <memory>
+#include <string>
+
+class Image
+{
+public:
+    Image(const std::string &filePath, bool flipY = false);
+    int getWidth() const;
+    int getHeight() const;
+    int getChannels() const;
+    const unsigned char *getPixels() const;
+    size_t getByteSize() const;
+
+private:
+    struct PixelDeleter
+    {
+        void operator()(unsigned char *pixels) const;
+    };
+
+    std::unique_ptr<unsigned char, PixelDeleter> pixels;
+    int width = 0, height = 0, channels = 0;
+};
\ No newline at end of file
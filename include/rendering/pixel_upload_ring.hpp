@@ -0,0 +1,31 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+
+class PixelUploadRing
+{
+public:
+    explicit PixelUploadRing(size_t bufferCount = 3, size_t initialBufferSize = 4 * 1024 * 1024);
+    ~PixelUploadRing();
+    PixelUploadRing(const PixelUploadRing &) = delete;
+    PixelUploadRing &operator=(const PixelUploadRing &) = delete;
+    void upload(int width, int height, const unsigned char *rgbaPixels);
+    bool isPersistent() const;
+
+private:
+    struct Slot
+    {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+        void *mapped = nullptr;
+        size_t capacity = 0;
+    };
+
+    void waitForSlot(Slot &slot);
+    void allocate(Slot &slot, size_t capacity);
+    void release(Slot &slot);
+
+    std::vector<Slot> slots;
+    size_t nextSlot = 0;
+    bool persistent = false;
+};
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+
+struct PackedRect
+{
+    int x = 0, y = 0, width = 0, height = 0;
+};
+
+class RectPacker
+{
+public:
+    RectPacker(int width, int height);
+    bool pack(int rectWidth, int rectHeight, PackedRect &packed);
+    void reset();
+    int getWidth() const;
+    int getHeight() const;
+    float getOccupancy() const;
+
+private:
+    struct SkylineNode
+    {
+        int x, y, width;
+    };
+
+    bool findPosition(int rectWidth, int rectHeight, size_t &bestNode, int &bestX, int &bestY) const;
+    bool fits(size_t node, int rectWidth, int rectHeight, int &y) const;
+
+    int width, height;
+    long long usedArea = 0;
+    std::vector<SkylineNode> skyline;
+};
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include "core/triple_buffer.hpp"
+#include "rendering/sprite_batch.hpp"
+#include "rendering/ui/imgui_draw_snapshot.hpp"
+
+struct GLFWwindow;
+
+// Everything the render thread needs to draw one frame.
+struct FrameSnapshot
+{
+    SpriteBatch sprites;
+    ImGuiDrawSnapshot ui;
+};
+
+// Owns the window's GL context on a thread of its own. The simulation thread
+// fills getWriteSnapshot() and publish()es it; the render thread draws the
+// newest snapshot and presents, so a frame's simulation overlaps the previous
+// frame's swap. The window's context must be current on the constructing
+// thread, and is made current there again on destruction.
+class RenderThread
+{
+public:
+    using RenderFunction = std::function<void(FrameSnapshot &)>;
+
+    RenderThread(GLFWwindow *window, RenderFunction renderFrame);
+    ~RenderThread();
+    RenderThread(const RenderThread &) = delete;
+    RenderThread &operator=(const RenderThread &) = delete;
+    FrameSnapshot &getWriteSnapshot();
+    // Blocks while the render thread is more than one frame behind, and
+    // rethrows anything the render function threw.
+    void publish();
+    uint64_t getRenderedFrameCount() const;
+
+private:
+    void run();
+
+    GLFWwindow *window;
+    RenderFunction renderFrame;
+    TripleBuffer<FrameSnapshot> snapshots;
+    std::atomic<uint64_t> publishedFrames = 0,
+                          renderedFrames = 0;
+    std::atomic<bool> stopping = false,
+                      failed = false;
+    std::exception_ptr error;
+    std::thread thread;
+};
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+// One instance of the sprite shader's quad. The layout is the vertex format,
+// so keep it in sync with SpriteRenderer.
+struct SpriteInstance
+{
+    glm::vec4 rect;   // x, y, width, height in UI units, y down
+    glm::vec4 uvRect; // u0, v0, u1, v1
+    uint32_t color;   // 0xAABBGGRR like IM_COL32, multiplied with the texture
+    float rotation;   // radians about the centre
+};
+
+struct SpriteDrawRange
+{
+    GLuint texture;
+    size_t first,
+        count;
+};
+
+// Collects the sprites of one frame. Makes no GL calls, so states can fill
+// it from render() on any thread; SpriteRenderer draws it. Sprites are drawn
+// in layer order and grouped by texture within a layer, so overlapping
+// sprites that share a layer but not a texture have no defined order.
+class SpriteBatch
+{
+public:
+    void begin(glm::vec2 viewSize, glm::ivec2 framebufferSize);
+    void draw(
+        GLuint texture,
+        glm::vec2 position,
+        glm::vec2 size,
+        glm::vec4 uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+        uint32_t color = 0xFFFFFFFF,
+        float rotation = 0.0f,
+        int layer = 0);
+    // Sorts by layer, then texture, keeping submission order otherwise,
+    // and builds one draw range per run of a texture.
+    void end();
+    const std::vector<SpriteInstance> &getInstances() const;
+    const std::vector<SpriteDrawRange> &getDrawRanges() const;
+    glm::vec2 getViewSize() const;
+    glm::ivec2 getFramebufferSize() const;
+    size_t size() const;
+    bool isEmpty() const;
+
+private:
+    struct SortEntry
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::vector<SpriteInstance> submitted, instances;
+    std::vector<SortEntry> sortEntries;
+    std::vector<SpriteDrawRange> drawRanges;
+    glm::vec2 viewSize;
+    glm::ivec2 framebufferSize;
+};
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+#include "rendering/sprite_batch.hpp"
+
+// Draws a SpriteBatch as one instanced quad draw per texture run. Instances
+// stream through a persistently mapped ring of buffer regions on GL 4.4 and
+// through an orphaned buffer on plain 3.3. Sets the GL state it needs and
+// leaves blending on, so ImGui drawn afterwards composites on top.
+class SpriteRenderer
+{
+public:
+    explicit SpriteRenderer(size_t initialCapacity = 4096, size_t regionCount = 3);
+    ~SpriteRenderer();
+    SpriteRenderer(const SpriteRenderer &) = delete;
+    SpriteRenderer &operator=(const SpriteRenderer &) = delete;
+    void render(const SpriteBatch &batch);
+    size_t getDrawCallCount() const;
+    bool isPersistent() const;
+
+private:
+    struct Region
+    {
+        GLsync fence = nullptr;
+    };
+
+    void createProgram();
+    void allocate(size_t capacity);
+    void release();
+    void waitForRegion(Region &region);
+    size_t upload(const std::vector<SpriteInstance> &instances);
+    void setInstanceOffset(size_t firstInstance);
+
+    GLuint program = 0,
+           vertexArray = 0,
+           buffer = 0;
+    GLint projectionLocation = -1,
+          textureLocation = -1;
+    std::vector<Region> regions;
+    size_t nextRegion = 0,
+           capacity = 0,
+           drawCallCount = 0;
+    void *mapped = nullptr;
+    bool persistent = false;
+};
\ No newline at end of file
@@ -3,18 +3,56 @@
 #include <string>
 #include <glm/gtc/matrix_transform.hpp>
 
+class CookedTexture;
+class Image;
+class PixelUploadRing;
+
+struct TextureSettings
+{
+    GLint minFilter = GL_NEAREST,
+          magFilter = GL_NEAREST,
+          wrap = GL_CLAMP_TO_EDGE;
+    bool immutableStorage = false;
+
+    bool usesMipmaps() const
+    {
+        return minFilter != GL_NEAREST && minFilter != GL_LINEAR;
+    }
+};
+
 class Texture2D
 {
 public:
     Texture2D(const std::string &filePath, bool flipY = false);
+    explicit Texture2D(
+        const Image &image,
+        const TextureSettings &settings = {},
+        PixelUploadRing *uploadRing = nullptr);
+    Texture2D(
+        int width, int height, const unsigned char *rgbaPixels,
+        const TextureSettings &settings = {},
+        PixelUploadRing *uploadRing = nullptr);
+    explicit Texture2D(const CookedTexture &cookedTexture, const TextureSettings &settings = {});
     ~Texture2D();
+    Texture2D(const Texture2D &) = delete;
+    Texture2D &operator=(const Texture2D &) = delete;
     void bind() const;
     unsigned int getWidth() const;
     unsigned int getHeight() const;
+    int getMipLevels() const;
+    size_t getByteSize() const;
     GLuint getTextureID() const;
     std::pair<glm::vec2, glm::vec2> getUVRange(int frameIndex, int tileSize, bool flipY = true) const;
+    // getUVRange for a texture of the given size, without needing one.
+    static std::pair<glm::vec2, glm::vec2> getTileUVRange(int width, int height, int frameIndex, int tileSize, bool flipY = true);
 
 private:
+    void upload(const unsigned char *rgbaPixels, const TextureSettings &settings, PixelUploadRing *uploadRing);
+    void uploadCooked(const CookedTexture &cookedTexture, const TextureSettings &settings);
+    void createTexture(const TextureSettings &settings);
+    void deleteTexture();
+
     GLuint textureID = 0;
-    int width = 0, height = 0, channels = 0;
+    int width = 0, height = 0, channels = 0, mipLevels = 1;
+    size_t byteSize = 0;
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "rendering/atlas_layout.hpp"
+#include "rendering/texture2d.hpp"
+
+class Image;
+
+// An AtlasLayout with its pages uploaded as textures.
+class TextureAtlas
+{
+public:
+    TextureAtlas(const std::vector<AtlasSource> &sources, int pageSize = 2048, int padding = 1);
+    static AtlasSource makeSource(const std::string &name, const Image &image);
+    uint32_t getFrameIndex(const std::string &name) const;
+    size_t getFrameCount() const;
+    const UVRect &getUV(uint32_t frame) const;
+    uint16_t getPage(uint32_t frame) const;
+    void getUVs(std::span<const uint32_t> frames, std::span<UVRect> uvs) const;
+    size_t getPageCount() const;
+    const Texture2D &getPageTexture(size_t page) const;
+    const AtlasLayout &getLayout() const;
+
+private:
+    AtlasLayout layout;
+    std::vector<std::unique_ptr<Texture2D>> pageTextures;
+};
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "rendering/texture_loader.hpp"
+
+// Safe to share between the thread that loads (states) and the one that
+// trims (whichever owns the GL context).
+class TextureCache
+{
+public:
+    struct Stats
+    {
+        size_t hits = 0,
+               misses = 0,
+               evictions = 0;
+    };
+
+    explicit TextureCache(TextureLoader &textureLoader, size_t budgetBytes = 256 * 1024 * 1024);
+    std::shared_ptr<TextureHandle> load(const std::string &filePath, bool flipY = false);
+    void trim();
+    void setBudget(size_t budgetBytes);
+    size_t getBudget() const;
+    size_t getResidentBytes() const;
+    size_t size() const;
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<TextureHandle> handle;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    static std::string makeKey(const std::string &filePath, bool flipY);
+    void eraseLocked(std::unordered_map<std::string, Entry>::iterator entry);
+    size_t getResidentBytesLocked() const;
+    static size_t getTextureBytes(const TextureHandle &handle);
+
+    TextureLoader &textureLoader;
+    std::unordered_map<std::string, Entry> entries;
+    std::list<std::string> lru;
+    size_t budgetBytes;
+    Stats stats;
+    mutable std::mutex mutex;
+};
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "core/thread_pool.hpp"
+#include "rendering/cooked_texture.hpp"
+#include "rendering/image.hpp"
+#include "rendering/pixel_upload_ring.hpp"
+#include "rendering/texture2d.hpp"
+
+class TextureHandle
+{
+public:
+    TextureHandle(std::string filePath, bool flipY, std::shared_ptr<const Texture2D> placeholder);
+    bool isReady() const;
+    bool hasFailed() const;
+    const std::string &getFilePath() const;
+    bool getFlipY() const;
+    size_t getFileSize() const;
+    const Texture2D &getTexture() const;
+    GLuint getTextureID() const;
+
+private:
+    friend class TextureLoader;
+
+    std::string filePath;
+    bool flipY = false;
+    // Set by the loading worker, so 0 until it has looked at the file.
+    std::atomic<size_t> fileSize = 0;
+    std::shared_ptr<const Texture2D> placeholder;
+    std::unique_ptr<Texture2D> texture;
+    std::atomic<bool> ready = false,
+                      failed = false;
+};
+
+class TextureLoader
+{
+public:
+    explicit TextureLoader(size_t workerCount = 2);
+    std::shared_ptr<TextureHandle> load(const std::string &filePath, bool flipY = false);
+    // Never throws for a bad file; the handle is marked failed instead.
+    void processUploads(double budgetSeconds);
+    size_t getPendingCount() const;
+    const Texture2D &getPlaceholder() const;
+
+private:
+    struct DecodedImage
+    {
+        std::shared_ptr<TextureHandle> handle;
+        std::unique_ptr<Image> image;
+        std::unique_ptr<CookedTexture> cookedTexture;
+        std::exception_ptr error;
+    };
+
+    static void reportFailure(const TextureHandle &handle, const std::exception_ptr &error);
+
+    std::shared_ptr<const Texture2D> placeholder;
+    PixelUploadRing uploadRing;
+    std::deque<DecodedImage> decoded;
+    mutable std::mutex decodedMutex;
+    std::atomic<size_t> pendingCount = 0;
+    ThreadPool workers;
+};
\ No newline at end of file
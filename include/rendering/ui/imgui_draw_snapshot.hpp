@@ -0,0 +1,22 @@
+#pragma once
+#include <imgui.h>
+#include <memory>
+#include <vector>
+
+// A deep copy of one frame of ImGui draw data. ImGui reuses its own draw
+// lists as soon as the next NewFrame starts, so a frame that is drawn on
+// another thread has to be captured first. Lists and their buffers are kept
+// between captures and only grow.
+class ImGuiDrawSnapshot
+{
+public:
+    ImGuiDrawSnapshot() = default;
+    ImGuiDrawSnapshot(const ImGuiDrawSnapshot &) = delete;
+    ImGuiDrawSnapshot &operator=(const ImGuiDrawSnapshot &) = delete;
+    void capture(const ImDrawData &source);
+    ImDrawData &getDrawData();
+
+private:
+    std::vector<std::unique_ptr<ImDrawList>> drawLists;
+    ImDrawData drawData;
+};
\ No newline at end of file
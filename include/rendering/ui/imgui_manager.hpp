@@ -1,9 +1,32 @@
 #pragma once
+#include <cstdint>
 #include <imgui.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include "rendering/ui/imgui_draw_snapshot.hpp"
+#include "rendering/ui/view_transform.hpp"
 class Camera2D;
 class GLFWwindow;
 
+// Viewport-derived values, refreshed once per frame by ImGuiManager. The
+// generation changes whenever any of them does, so states can compute their
+// layout once and redo it only when the generation moves on.
+struct UiLayout
+{
+    ImVec2 position,
+        size;
+    glm::vec2 scale = glm::vec2(1.0f); // framebuffer pixels per UI unit
+    uint64_t generation = 0;
+
+    ImVec2 getCenteredPosition(ImVec2 itemSize) const
+    {
+        return ImVec2(
+            position.x + (size.x - itemSize.x) * 0.5f,
+            position.y + (size.y - itemSize.y) * 0.5f);
+    }
+};
+
+// Passing a null window runs ImGui without platform or renderer backends:
+// frames are still built, so state UI code runs, but nothing is drawn.
 class ImGuiManager
 {
 public:
@@ -15,6 +38,12 @@ public:
     ~ImGuiManager();
     void newFrame();
     void renderFrame();
+    // With the renderer detached, frames are built here but drawn elsewhere:
+    // captureFrame copies the finished frame and renderSnapshot draws it on
+    // whichever thread owns the GL context.
+    void setRendererDetached(bool detached);
+    void captureFrame(ImGuiDrawSnapshot &snapshot);
+    void renderSnapshot(ImGuiDrawSnapshot &snapshot);
     ImGuiIO &getIO() const;
     ImVec2 worldToScreen(
         glm::vec2 cameraRelative,
@@ -24,11 +53,30 @@ public:
         ImVec2 screenPosition,
         float zoom,
         glm::vec2 cameraLeftPosition) const;
+    // For many points, take the transform once per frame and use the batch
+    // conversions in view_transform.hpp; these overloads do both at once.
+    ViewTransform getViewTransform(float zoom, glm::vec2 cameraLeftPosition) const;
+    void worldToScreen(
+        std::span<const glm::vec2> cameraRelative,
+        std::span<ImVec2> screenPositions,
+        float zoom,
+        glm::vec2 cameraLeftPosition) const;
+    void screenToWorld(
+        std::span<const ImVec2> screenPositions,
+        std::span<glm::vec2> worldPositions,
+        float zoom,
+        glm::vec2 cameraLeftPosition) const;
     glm::vec2 getUiScale() const;
     void resize(int windowWidth, int windowHeight);
     ImVec2 getUiDimensions() const;
+    const UiLayout &getLayout() const;
 
 private:
+    void refreshLayout();
+
     GLFWwindow *window;
+    bool rendererDetached = false;
     int windowWidth = 800, windowHeight = 600;
+    UiLayout layout;
+    bool layoutDirty = true;
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <imgui.h>
+#include <span>
+#include <glm/gtc/matrix_transform.hpp>
+
+// The world to UI mapping of one camera for one frame, so batches of points
+// can be converted without recomputing the UI scale per point. Build it with
+// ImGuiManager::getViewTransform once the frame's display size is known.
+struct ViewTransform
+{
+    glm::vec2 cameraTopLeft;
+    glm::vec2 worldToScreenScale; // zoom / UI scale
+    glm::vec2 screenToWorldScale; // UI scale / zoom
+
+    static ViewTransform create(float zoom, glm::vec2 cameraTopLeft, glm::vec2 uiScale);
+};
+
+// Batch conversions, vectorised with AVX where the CPU has it, SSE where the
+// build targets it and scalar otherwise. Outputs must be the same length as
+// the inputs and may alias them exactly but not partially.
+// Interleaved x, y points (AoS).
+void worldToScreen(const ViewTransform &transform, std::span<const glm::vec2> world, std::span<ImVec2> screen);
+void screenToWorld(const ViewTransform &transform, std::span<const ImVec2> screen, std::span<glm::vec2> world);
+// Separate x and y arrays (SoA).
+void worldToScreen(
+    const ViewTransform &transform,
+    std::span<const float> worldX,
+    std::span<const float> worldY,
+    std::span<float> screenX,
+    std::span<float> screenY);
+void screenToWorld(
+    const ViewTransform &transform,
+    std::span<const float> screenX,
+    std::span<const float> screenY,
+    std::span<float> worldX,
+    std::span<float> worldY);
+// The instruction set the batch conversions use on this machine.
+const char *getViewTransformIsa();
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include "core/block_pool.hpp"
+
+BlockPool::BlockPool(size_t blockSize, size_t blockAlignment, size_t blocksPerChunk)
+    : blockSize(blockSize), blockAlignment(blockAlignment), blocksPerChunk(blocksPerChunk)
+{
+    if (blockSize == 0)
+        throw std::invalid_argument("BlockPool: blockSize must be positive");
+    if (blockAlignment == 0 || (blockAlignment & (blockAlignment - 1)) != 0)
+        throw std::invalid_argument("BlockPool: blockAlignment must be a power of two");
+    if (blocksPerChunk == 0)
+        throw std::invalid_argument("BlockPool: blocksPerChunk must be positive");
+
+    // A free block stores the free-list link in place, so it has to fit one.
+    this->blockAlignment = std::max(blockAlignment, alignof(FreeBlock));
+    blockStride = std::max(blockSize, sizeof(FreeBlock));
+    blockStride = (blockStride + this->blockAlignment - 1) & ~(this->blockAlignment - 1);
+}
+
+BlockPool::~BlockPool()
+{
+    for (void *chunk : chunks)
+        ::operator delete(chunk, std::align_val_t(blockAlignment));
+}
+
+void *BlockPool::allocate()
+{
+    std::lock_guard lock(mutex);
+    if (!freeList)
+        addChunk();
+
+    FreeBlock *block = freeList;
+    freeList = block->next;
+    ++liveCount;
+    return block;
+}
+
+void BlockPool::deallocate(void *block)
+{
+    if (!block)
+        return;
+
+    std::lock_guard lock(mutex);
+    freeList = new (block) FreeBlock{freeList};
+    --liveCount;
+}
+
+size_t BlockPool::getBlockSize() const
+{
+    return blockSize;
+}
+
+size_t BlockPool::getCapacity() const
+{
+    std::lock_guard lock(mutex);
+    return chunks.size() * blocksPerChunk;
+}
+
+size_t BlockPool::getLiveCount() const
+{
+    std::lock_guard lock(mutex);
+    return liveCount;
+}
+
+void BlockPool::addChunk()
+{
+    chunks.reserve(chunks.size() + 1);
+    auto *chunk = static_cast<unsigned char *>(::operator new(blockStride * blocksPerChunk, std::align_val_t(blockAlignment)));
+    chunks.push_back(chunk);
+
+    // Thread the new blocks onto the free list back to front so they are
+    // handed out in address order.
+    for (size_t i = blocksPerChunk; i > 0; --i)
+        freeList = new (chunk + (i - 1) * blockStride) FreeBlock{freeList};
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "core/event_bus.hpp"
+
+void Subscription::reset()
+{
+    if (!bus)
+        return;
+
+    bus->unsubscribe(typeId, id);
+    bus = nullptr;
+}
+
+EventBus::EventBus()
+    : head(&stub), tail(&stub)
+{
+}
+
+EventBus::~EventBus()
+{
+    while (QueuedEventBase *node = pop())
+        delete node;
+}
+
+void EventBus::setEnqueueCallback(std::function<void()> callback)
+{
+    enqueueCallback = std::move(callback);
+}
+
+size_t EventBus::dispatchQueued()
+{
+    // Between calls the stub is only at head when nothing is queued.
+    QueuedEventBase *last = head.load(std::memory_order_acquire);
+    if (last == &stub)
+        return 0;
+
+    size_t count = 0;
+    while (QueuedEventBase *node = pop())
+    {
+        std::unique_ptr<QueuedEventBase> event(node);
+        bool reachedLast = node == last;
+        event->dispatch(*this);
+        ++count;
+        if (reachedLast)
+            break;
+    }
+    return count;
+}
+
+size_t EventBus::getSubscriberCount() const
+{
+    size_t count = 0;
+    for (const auto &channel : channels)
+    {
+        if (channel)
+            count += channel->size();
+    }
+    return count;
+}
+
+void EventBus::unsubscribe(size_t typeId, uint64_t id)
+{
+    if (typeId < channels.size() && channels[typeId])
+        channels[typeId]->remove(id);
+}
+
+void EventBus::push(QueuedEventBase *node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    QueuedEventBase *previous = head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+EventBus::QueuedEventBase *EventBus::pop()
+{
+    QueuedEventBase *first = tail;
+    QueuedEventBase *next = first->next.load(std::memory_order_acquire);
+    if (first == &stub)
+    {
+        if (!next)
+            return nullptr;
+
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next)
+    {
+        tail = next;
+        return first;
+    }
+
+    // A producer has swapped itself in at head but not linked it yet; its
+    // event, and any after it, wait for the next dispatch.
+    if (first != head.load(std::memory_order_acquire))
+        return nullptr;
+
+    // first is the only node left. Queue the stub behind it so it can be
+    // unlinked without leaving the queue empty.
+    push(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next)
+    {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <stdexcept>
+#include "core/job_system.hpp"
+
+namespace
+{
+    struct WorkerIdentity
+    {
+        const JobSystem *jobSystem = nullptr;
+        size_t queueIndex = 0;
+    };
+
+    thread_local WorkerIdentity currentWorker;
+}
+
+bool JobGroup::isDone() const
+{
+    return pending.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::JobSystem(size_t workerCount)
+{
+    if (workerCount == 0)
+        throw std::invalid_argument("JobSystem: workerCount must be positive");
+
+    queues.reserve(workerCount + 1);
+    for (size_t i = 0; i < workerCount + 1; ++i)
+        queues.push_back(std::make_unique<Queue>());
+
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back([this, i]()
+                             { workerLoop(i + 1); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void JobSystem::run(JobGroup &group, std::function<void()> job)
+{
+    if (!job)
+        throw std::invalid_argument("JobSystem: run received empty job");
+
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    Queue &queue = *queues[getQueueIndex()];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.push_back({std::move(job), &group});
+    }
+
+    {
+        // Taking the lock orders the increment with a worker deciding to sleep.
+        std::lock_guard lock(sleepMutex);
+        queuedJobs.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_one();
+}
+
+void JobSystem::wait(JobGroup &group)
+{
+    size_t queueIndex = getQueueIndex();
+    while (!group.isDone())
+    {
+        if (!tryRunJob(queueIndex))
+            std::this_thread::yield();
+    }
+
+    std::lock_guard lock(group.errorMutex);
+    if (group.error)
+    {
+        std::exception_ptr error = group.error;
+        group.error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)> &body)
+{
+    if (!body)
+        throw std::invalid_argument("JobSystem: parallelFor received empty body");
+    if (count == 0)
+        return;
+
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    // The caller keeps the first range for itself rather than idling in wait.
+    JobGroup group;
+    for (size_t begin = grainSize; begin < count; begin += grainSize)
+    {
+        size_t end = std::min(begin + grainSize, count);
+        run(group, [&body, begin, end]()
+            { body(begin, end); });
+    }
+
+    try
+    {
+        body(0, std::min(grainSize, count));
+    }
+    catch (...)
+    {
+        wait(group);
+        throw;
+    }
+    wait(group);
+}
+
+size_t JobSystem::getWorkerCount() const
+{
+    return workers.size();
+}
+
+size_t JobSystem::getQueueIndex() const
+{
+    return currentWorker.jobSystem == this ? currentWorker.queueIndex : 0;
+}
+
+bool JobSystem::tryRunJob(size_t queueIndex)
+{
+    Job job;
+    if (!takeJob(queueIndex, job))
+        return false;
+
+    execute(job);
+    return true;
+}
+
+bool JobSystem::takeJob(size_t queueIndex, Job &job)
+{
+    {
+        // Newest first from our own queue: its data is most likely still in cache.
+        Queue &queue = *queues[queueIndex];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Oldest first from everyone else's, which tends to be the biggest chunk.
+    for (size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        Queue &queue = *queues[(queueIndex + offset) % queues.size()];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(Job &job)
+{
+    try
+    {
+        job.function();
+    }
+    catch (...)
+    {
+        std::lock_guard lock(job.group->errorMutex);
+        if (!job.group->error)
+            job.group->error = std::current_exception();
+    }
+
+    job.group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(size_t queueIndex)
+{
+    currentWorker = {this, queueIndex};
+    while (true)
+    {
+        if (tryRunJob(queueIndex))
+            continue;
+
+        std::unique_lock lock(sleepMutex);
+        wake.wait(lock, [this]()
+                  { return stopping || queuedJobs.load(std::memory_order_acquire) > 0; });
+        if (stopping)
+            return;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <stdexcept>
+#include <utility>
+#include "core/mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &filePath)
+{
+    if (filePath.empty())
+        throw std::invalid_argument("MappedFile: filePath must not be empty");
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(
+        filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("MappedFile: failed to open " + filePath);
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("MappedFile: failed to stat " + filePath);
+    }
+
+    fileHandle = file;
+    byteSize = static_cast<size_t>(fileSize.QuadPart);
+    open = true;
+    if (byteSize == 0)
+        return;
+
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle)
+    {
+        close();
+        throw std::runtime_error("MappedFile: failed to map " + filePath);
+    }
+
+    bytes = static_cast<const unsigned char *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!bytes)
+    {
+        close();
+        throw std::runtime_error("MappedFile: failed to map " + filePath);
+    }
+#else
+    int file = ::open(filePath.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error("MappedFile: failed to open " + filePath);
+
+    struct stat status;
+    if (fstat(file, &status) != 0)
+    {
+        ::close(file);
+        throw std::runtime_error("MappedFile: failed to stat " + filePath);
+    }
+
+    byteSize = static_cast<size_t>(status.st_size);
+    open = true;
+    if (byteSize > 0)
+    {
+        void *mapped = mmap(nullptr, byteSize, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapped == MAP_FAILED)
+        {
+            ::close(file);
+            byteSize = 0;
+            open = false;
+            throw std::runtime_error("MappedFile: failed to map " + filePath);
+        }
+        bytes = static_cast<const unsigned char *>(mapped);
+    }
+
+    // The mapping keeps the file alive on its own.
+    ::close(file);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        bytes = std::exchange(other.bytes, nullptr);
+        byteSize = std::exchange(other.byteSize, 0);
+        open = std::exchange(other.open, false);
+#ifdef _WIN32
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+const unsigned char *MappedFile::data() const
+{
+    return bytes;
+}
+
+size_t MappedFile::size() const
+{
+    return byteSize;
+}
+
+bool MappedFile::isOpen() const
+{
+    return open;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (bytes)
+        UnmapViewOfFile(bytes);
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+    if (fileHandle)
+        CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (bytes)
+        munmap(const_cast<unsigned char *>(bytes), byteSize);
+#endif
+    bytes = nullptr;
+    byteSize = 0;
+    open = false;
+}
\ No newline at end of file
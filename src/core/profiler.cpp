@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "core/profiler.hpp"
+
+namespace
+{
+    bool sameText(const char *a, const char *b)
+    {
+        if (a == b)
+            return true;
+        if (!a || !b)
+            return false;
+        return std::strcmp(a, b) == 0;
+    }
+
+    double percentile(const std::vector<double> &sorted, double fraction)
+    {
+        size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+}
+
+Profiler::Profiler(size_t historySize)
+    : historySize(historySize)
+{
+    if (historySize == 0)
+        throw std::invalid_argument("Profiler: historySize must be positive");
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    if (this->enabled == enabled)
+        return;
+
+    this->enabled = enabled;
+    clear();
+}
+
+bool Profiler::isEnabled() const
+{
+    return enabled;
+}
+
+void Profiler::beginFrame()
+{
+    if (!enabled)
+        return;
+
+    for (auto &section : sections)
+    {
+        section.cpu.commit();
+        section.gpu.commit();
+    }
+}
+
+void Profiler::record(const char *name, const char *detail, double seconds)
+{
+    if (!enabled)
+        return;
+
+    findSection(name, detail).cpu.add(seconds);
+}
+
+void Profiler::recordGpu(const char *name, const char *detail, double seconds)
+{
+    if (!enabled)
+        return;
+
+    findSection(name, detail).gpu.add(seconds);
+}
+
+std::vector<ProfileStats> Profiler::getStats() const
+{
+    std::vector<ProfileStats> stats;
+    stats.reserve(sections.size());
+
+    std::vector<double> scratch;
+    for (const auto &section : sections)
+    {
+        if (section.cpu.sampleCount == 0 && section.gpu.sampleCount == 0)
+            continue;
+
+        ProfileStats sectionStats;
+        sectionStats.label = section.label;
+        sectionStats.cpu = section.cpu.getStats(scratch);
+        sectionStats.gpu = section.gpu.getStats(scratch);
+        stats.push_back(std::move(sectionStats));
+    }
+    return stats;
+}
+
+size_t Profiler::getHistorySize() const
+{
+    return historySize;
+}
+
+void Profiler::clear()
+{
+    sections.clear();
+}
+
+Profiler::Section &Profiler::findSection(const char *name, const char *detail)
+{
+    if (!name)
+        throw std::invalid_argument("Profiler: record received null name");
+
+    // A frame touches a dozen or so sections, so a linear scan with pointer
+    // comparisons first beats hashing strings.
+    for (auto &section : sections)
+    {
+        if (sameText(section.name, name) && sameText(section.detail, detail))
+            return section;
+    }
+
+    Section section;
+    section.name = name;
+    section.detail = detail;
+    section.label = detail ? std::string(name) + "::" + detail : std::string(name);
+    section.cpu.samples.resize(historySize);
+    section.gpu.samples.resize(historySize);
+    sections.push_back(std::move(section));
+    return sections.back();
+}
+
+void Profiler::SampleRing::add(double seconds)
+{
+    // Several fixed steps in one frame add up to that frame's cost.
+    current += seconds;
+    touched = true;
+}
+
+void Profiler::SampleRing::commit()
+{
+    // Sections that did not run this frame (a covered state, a frame with no
+    // fixed steps) keep their history instead of recording a zero.
+    if (!touched)
+        return;
+
+    samples[nextSample] = current;
+    nextSample = (nextSample + 1) % samples.size();
+    sampleCount = std::min(sampleCount + 1, samples.size());
+    current = 0.0;
+    touched = false;
+}
+
+TimingStats Profiler::SampleRing::getStats(std::vector<double> &scratch) const
+{
+    TimingStats stats;
+    stats.sampleCount = sampleCount;
+    if (sampleCount == 0)
+        return stats;
+
+    stats.last = samples[(nextSample + samples.size() - 1) % samples.size()];
+
+    scratch.assign(samples.begin(), samples.begin() + sampleCount);
+    std::sort(scratch.begin(), scratch.end());
+    stats.p50 = percentile(scratch, 0.50);
+    stats.p95 = percentile(scratch, 0.95);
+    stats.p99 = percentile(scratch, 0.99);
+    return stats;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <cmath>
+#include <stdexcept>
+#include "game/fixed_timestep.hpp"
+
+FixedTimestep::FixedTimestep(double tickRate, int maxCatchUpSteps)
+{
+    setTickRate(tickRate);
+    setMaxCatchUpSteps(maxCatchUpSteps);
+}
+
+int FixedTimestep::advance(double frameTime)
+{
+    if (frameTime > 0.0)
+        accumulator += frameTime;
+
+    int steps = static_cast<int>(accumulator / stepSize);
+    if (steps > maxCatchUpSteps)
+    {
+        // Dropping the backlog avoids the spiral of death where catching up
+        // takes longer than the time it is catching up on.
+        steps = maxCatchUpSteps;
+        accumulator = std::fmod(accumulator, stepSize) + steps * stepSize;
+    }
+
+    accumulator -= steps * stepSize;
+    return steps;
+}
+
+void FixedTimestep::reset()
+{
+    accumulator = 0.0;
+}
+
+void FixedTimestep::setTickRate(double tickRate)
+{
+    if (!(tickRate > 0.0))
+        throw std::invalid_argument("FixedTimestep: tickRate must be positive");
+
+    stepSize = 1.0 / tickRate;
+}
+
+void FixedTimestep::setMaxCatchUpSteps(int maxCatchUpSteps)
+{
+    if (maxCatchUpSteps < 1)
+        throw std::invalid_argument("FixedTimestep: maxCatchUpSteps must be at least 1");
+
+    this->maxCatchUpSteps = maxCatchUpSteps;
+}
+
+double FixedTimestep::getTickRate() const
+{
+    return 1.0 / stepSize;
+}
+
+double FixedTimestep::getStepSize() const
+{
+    return stepSize;
+}
+
+int FixedTimestep::getMaxCatchUpSteps() const
+{
+    return maxCatchUpSteps;
+}
+
+float FixedTimestep::getAlpha() const
+{
+    return static_cast<float>(accumulator / stepSize);
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include "game/frame_pacer.hpp"
+
+namespace
+{
+    constexpr auto spinThreshold = std::chrono::milliseconds(2);
+    constexpr double lateLatchMargin = 0.001;
+
+    FramePacer::Clock::duration toDuration(double seconds)
+    {
+        return std::chrono::duration_cast<FramePacer::Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+}
+
+FramePacer::FramePacer()
+{
+    reset();
+}
+
+void FramePacer::setMode(PresentMode mode)
+{
+    if (this->mode == mode)
+        return;
+
+    this->mode = mode;
+    reset();
+}
+
+PresentMode FramePacer::getMode() const
+{
+    return mode;
+}
+
+void FramePacer::setFrameRateCap(double framesPerSecond)
+{
+    if (framesPerSecond <= 0.0)
+        throw std::invalid_argument("FramePacer: framesPerSecond must be positive");
+
+    frameRateCap = framesPerSecond;
+    if (mode == PresentMode::Capped)
+        reset();
+}
+
+double FramePacer::getFrameRateCap() const
+{
+    return frameRateCap;
+}
+
+void FramePacer::setRefreshRate(double refreshRate)
+{
+    if (refreshRate <= 0.0)
+        throw std::invalid_argument("FramePacer: refreshRate must be positive");
+
+    this->refreshRate = refreshRate;
+}
+
+double FramePacer::getRefreshRate() const
+{
+    return refreshRate;
+}
+
+void FramePacer::setAdaptiveVsyncSupported(bool supported)
+{
+    adaptiveVsyncSupported = supported;
+}
+
+void FramePacer::setLateLatchEnabled(bool enabled)
+{
+    lateLatchEnabled = enabled;
+}
+
+bool FramePacer::isLateLatchEnabled() const
+{
+    return lateLatchEnabled;
+}
+
+int FramePacer::getSwapInterval() const
+{
+    switch (mode)
+    {
+    case PresentMode::Vsync:
+        return 1;
+    case PresentMode::AdaptiveVsync:
+        return adaptiveVsyncSupported ? -1 : 1;
+    default:
+        return 0;
+    }
+}
+
+double FramePacer::getTargetFrameTime() const
+{
+    switch (mode)
+    {
+    case PresentMode::Uncapped:
+        return 0.0;
+    case PresentMode::Capped:
+        return 1.0 / frameRateCap;
+    default:
+        return 1.0 / refreshRate;
+    }
+}
+
+void FramePacer::beginFrame()
+{
+    if (lateLatchEnabled && hasDeadline)
+        waitUntil(deadline - toDuration(predictedWorkTime + lateLatchMargin));
+
+    workStartTime = Clock::now();
+}
+
+void FramePacer::waitForPresent()
+{
+    stats.lastWorkTime = std::chrono::duration<double>(Clock::now() - workStartTime).count();
+
+    // Jumps up to a slow frame at once but only creeps back down, so a
+    // single quick frame does not make the next latch too late.
+    predictedWorkTime = std::max(stats.lastWorkTime, predictedWorkTime + (stats.lastWorkTime - predictedWorkTime) * 0.05);
+
+    if (mode == PresentMode::Capped && hasDeadline)
+        waitUntil(deadline);
+}
+
+void FramePacer::framePresented(Clock::time_point presentTime)
+{
+    double targetFrameTime = getTargetFrameTime();
+    if (stats.frameCount > 0 && !resumedAfterIdle)
+    {
+        stats.lastFrameTime = std::chrono::duration<double>(presentTime - lastPresentTime).count();
+
+        // Half a period late means at least one refresh, or cap slot, passed
+        // without a new frame.
+        if (targetFrameTime > 0.0 && stats.lastFrameTime > targetFrameTime * 1.5)
+            ++stats.missedDeadlines;
+    }
+    ++stats.frameCount;
+    lastPresentTime = presentTime;
+    resumedAfterIdle = false;
+
+    if (targetFrameTime <= 0.0)
+    {
+        hasDeadline = false;
+        return;
+    }
+
+    // A cap keeps its cadence while on schedule and restarts it after a
+    // miss instead of rushing to catch up. Vsync swaps return at a refresh,
+    // so the next one is always a period after the last.
+    Clock::duration period = toDuration(targetFrameTime);
+    if (mode == PresentMode::Capped && hasDeadline && presentTime < deadline + period)
+        deadline += period;
+    else
+        deadline = presentTime + period;
+    hasDeadline = true;
+}
+
+const FramePacingStats &FramePacer::getStats() const
+{
+    return stats;
+}
+
+void FramePacer::reset()
+{
+    stats = FramePacingStats{};
+    predictedWorkTime = 0.0;
+    hasDeadline = false;
+    resumedAfterIdle = false;
+    workStartTime = Clock::now();
+}
+
+void FramePacer::resumeAfterIdle()
+{
+    hasDeadline = false;
+    resumedAfterIdle = true;
+}
+
+void FramePacer::waitUntil(Clock::time_point deadline)
+{
+    Clock::time_point now = Clock::now();
+    if (deadline - now > spinThreshold)
+        std::this_thread::sleep_for(deadline - now - spinThreshold);
+
+    while (Clock::now() < deadline)
+        std::this_thread::yield();
+}
\ No newline at end of file
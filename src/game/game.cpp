@@ -1,63 +1,430 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <filesystem>
 #include <stdexcept>
+#include <thread>
 #include "game/game.hpp"
 #include "game/states/loading_state.hpp"
+#include "game/states/play_state.hpp"
+#include "game/states/splash_state.hpp"
+
+namespace
+{
+    // Whether ImGui owns the event because a widget is being typed into or
+    // the cursor is over a window. Releases always reach the states, so a
+    // key pressed before focusing a widget is never left held down.
+    bool capturedByUi(const ImGuiIO &io, const InputEvent &event)
+    {
+        if (event.action == InputAction::Release)
+            return false;
+
+        switch (event.type)
+        {
+        case InputEventType::Key:
+            return io.WantCaptureKeyboard;
+        case InputEventType::MouseButton:
+        case InputEventType::CursorMove:
+        case InputEventType::Scroll:
+            return io.WantCaptureMouse;
+        default:
+            return false;
+        }
+    }
+}
 
 Game::Game()
 {
+    fullscreenSubscription = events.subscribe<FullscreenToggled>(
+        [this](const FullscreenToggled &event)
+        {
+            setFullscreen(event.fullscreen);
+        });
+
+    // Events queued from other threads must not sit behind an idle wait.
+    events.setEnqueueCallback(
+        [this]()
+        {
+            requestRedraw();
+        });
 }
 
 Game::~Game()
 {
+    // Hands the context back to this thread before anything frees GL objects.
+    renderThread.reset();
+
+    // States may hold textures and ImGui state, so they go while the GL
+    // context and the ImGui backends are still alive.
+    stateStack.clear();
+    profilerOverlay.reset();
+    imGuiManager.reset();
+
+    spriteRenderer.reset();
+    textureCache.reset();
+    textureLoader.reset();
+    gpuProfiler.reset();
+
     if (window)
     {
         glfwDestroyWindow(window);
         window = nullptr;
     }
 
-    glfwTerminate();
+    if (backend == GameBackend::Windowed)
+        glfwTerminate();
+}
+
+void Game::run(size_t tickLimit)
+{
+    if (backend == GameBackend::Windowed)
+        lastFrameTime = glfwGetTime();
+    fixedTimestep.reset();
+    framePacer.reset();
+    size_t ticks = 0;
+    while (!shouldClose() && (tickLimit == 0 || ticks < tickLimit))
+    {
+        applyPipelinedRendering();
+        bool idled = waitForWork();
+
+        if (backend == GameBackend::Windowed)
+        {
+            if (idled)
+                framePacer.resumeAfterIdle();
+            framePacer.beginFrame();
+        }
+
+        profiler.beginFrame();
+        // GL timer queries would have to be issued from the render thread,
+        // and the profiler is not thread-safe, so GPU timings pause while
+        // rendering is pipelined.
+        if (gpuProfiler && !renderThread)
+            gpuProfiler->beginFrame();
+        ProfileScope frameScope(&profiler, "Game", "frame");
+
+        // Polled right before the updates that react to it, not after the
+        // previous frame's render and swap.
+        bool hadInput = processInput();
+        if (hadInput || redrawRequested.exchange(false, std::memory_order_relaxed))
+            activeFrames = settleFrames;
+        else if (activeFrames > 0)
+            --activeFrames;
+
+        double frameTime = advanceClock();
+
+        float alpha = 1.0f;
+        if (fixedTimestepEnabled)
+        {
+            size_t steps = static_cast<size_t>(fixedTimestep.advance(frameTime));
+            if (tickLimit != 0)
+                steps = std::min(steps, tickLimit - ticks);
+
+            for (size_t i = 0; i < steps; ++i)
+                update(static_cast<float>(fixedTimestep.getStepSize()));
+            ticks += steps;
+
+            alpha = fixedTimestep.getAlpha();
+        }
+        else
+        {
+            update(static_cast<float>(frameTime));
+            ++ticks;
+        }
+
+        {
+            // Reactions to this frame's updates run here, outside them.
+            ProfileScope eventsScope(&profiler, "EventBus", "dispatchQueued");
+            events.dispatchQueued();
+        }
+
+        // A minimized window has nothing to draw into.
+        if (!iconified)
+        {
+            render(alpha);
+            present();
+        }
+    }
+
+    renderThread.reset();
 }
 
-void Game::run()
+void Game::applyPipelinedRendering()
 {
-    float lastTime = glfwGetTime();
-    while (!glfwWindowShouldClose(window))
+    bool enabled = pipelinedRendering && backend == GameBackend::Windowed;
+    if (enabled == static_cast<bool>(renderThread))
+        return;
+
+    if (enabled)
     {
-        float currentTime = glfwGetTime();
-        float deltaTime = currentTime - lastTime;
-        lastTime = currentTime;
+        imGuiManager->setRendererDetached(true);
+        renderThread = std::make_unique<RenderThread>(
+            window,
+            [this](FrameSnapshot &snapshot)
+            {
+                drawSnapshot(snapshot);
+            });
+    }
+    else
+    {
+        renderThread.reset();
+        imGuiManager->setRendererDetached(false);
+    }
+}
 
-        update(deltaTime);
-        render();
+double Game::advanceClock()
+{
+    if (backend == GameBackend::Headless)
+    {
+        // A fake clock that advances exactly one fixed step per frame with no
+        // waiting in between. Handing out the step itself, not a difference
+        // of two times, keeps rounding from ever producing 0 or 2 ticks.
+        return fixedTimestep.getStepSize();
+    }
+
+    double currentTime = glfwGetTime();
+    double frameTime = currentTime - lastFrameTime;
+    lastFrameTime = currentTime;
+    return frameTime;
+}
+
+bool Game::shouldClose() const
+{
+    if (closeRequested)
+        return true;
+
+    return window && glfwWindowShouldClose(window);
+}
 
+void Game::present()
+{
+    if (backend == GameBackend::Headless)
+        return;
+
+    requestedSwapInterval.store(framePacer.getSwapInterval(), std::memory_order_relaxed);
+    {
+        ProfileScope paceScope(&profiler, "FramePacer", "waitForPresent");
+        framePacer.waitForPresent();
+    }
+
+    if (renderThread)
+    {
+        ProfileScope publishScope(&profiler, "Game", "publishFrame");
+        renderThread->publish();
+    }
+    else
+    {
+        ProfileScope swapScope(&profiler, "Game", "swapBuffers");
+        applySwapInterval();
         glfwSwapBuffers(window);
+    }
+    framePacer.framePresented();
+}
+
+void Game::applySwapInterval()
+{
+    int swapInterval = requestedSwapInterval.load(std::memory_order_relaxed);
+    if (swapInterval == appliedSwapInterval)
+        return;
+
+    glfwSwapInterval(swapInterval);
+    appliedSwapInterval = swapInterval;
+}
+
+bool Game::processInput()
+{
+    ProfileScope profileScope(&profiler, "Game", "processInput");
+
+    if (window)
+    {
         glfwPollEvents();
+        input.pollGamepads(glfwGetTime());
+    }
+
+    bool hadInput = false;
+    InputEvent event;
+    while (input.pop(event))
+    {
+        handleInput(event);
+        hadInput = true;
+    }
+    return hadInput;
+}
+
+bool Game::waitForWork()
+{
+    if (!window)
+        return false;
+
+    double timeout = getIdleTimeout();
+    if (timeout <= 0.0)
+        return false;
+
+    glfwWaitEventsTimeout(timeout);
+    return true;
+}
+
+double Game::getIdleTimeout() const
+{
+    bool busy = activeFrames > 0 ||
+                redrawRequested.load(std::memory_order_relaxed) ||
+                profiler.isEnabled() ||
+                stateStack.needsContinuousUpdates();
+    if (busy && focused && !iconified)
+        return 0.0;
+
+    // Idle, minimized or in the background: still tick, so timers and
+    // loading move on, but only a few times a second. Any event wakes the
+    // loop early.
+    return 1.0 / backgroundTickRate;
+}
+
+void Game::handleInput(const InputEvent &event)
+{
+    if (event.isKeyPress(InputKey::F3))
+    {
+        setProfilerEnabled(!profiler.isEnabled());
+        return;
     }
+
+    if (imGuiManager && capturedByUi(imGuiManager->getIO(), event))
+        return;
+
+    stateStack.handleInput(event);
 }
 
-void Game::setupGLFW(int windowWidth, int windowHeight)
+void Game::requestClose()
+{
+    closeRequested = true;
+    if (window)
+        glfwSetWindowShouldClose(window, true);
+}
+
+void Game::requestRedraw()
+{
+    redrawRequested.store(true, std::memory_order_relaxed);
+    if (window)
+        glfwPostEmptyEvent();
+}
+
+void Game::setupGLFW(const Settings &settings)
 {
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    window = glfwCreateWindow(windowWidth, windowHeight, "gamestate", NULL, NULL);
+    // Created in its final mode, so a fullscreen start never flashes a
+    // window that is then resized.
+    GLFWmonitor *monitor = settings.fullscreen ? glfwGetPrimaryMonitor() : nullptr;
+    const GLFWvidmode *mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    if (mode)
+    {
+        glfwWindowHint(GLFW_REFRESH_RATE, mode->refreshRate);
+        window = glfwCreateWindow(mode->width, mode->height, "gamestate", monitor, NULL);
+    }
+    else
+    {
+        window = glfwCreateWindow(settings.windowWidth, settings.windowHeight, "gamestate", NULL, NULL);
+    }
     if (!window)
         throw std::runtime_error("Failed to create glfw window");
 
     glfwMakeContextCurrent(window);
 
-    glfwSwapInterval(1);
+    framePacer.setAdaptiveVsyncSupported(
+        glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+        glfwExtensionSupported("GLX_EXT_swap_control_tear"));
+    if (const GLFWvidmode *mode = glfwGetVideoMode(glfwGetPrimaryMonitor()))
+        framePacer.setRefreshRate(mode->refreshRate);
+
+    appliedSwapInterval = framePacer.getSwapInterval();
+    requestedSwapInterval = appliedSwapInterval;
+    glfwSwapInterval(appliedSwapInterval);
 
     glfwSetWindowUserPointer(window, this);
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
 
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow *window, int windowWidth, int windowHeight)
                                    {
         if (Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window)))
             game->resize(windowWidth, windowHeight); });
+
+    glfwSetWindowIconifyCallback(window, [](GLFWwindow *window, int iconified)
+                                 {
+        if (Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window)))
+        {
+            game->iconified = iconified == GLFW_TRUE;
+            game->requestRedraw();
+        } });
+
+    glfwSetWindowFocusCallback(window, [](GLFWwindow *window, int focused)
+                               {
+        if (Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window)))
+        {
+            game->focused = focused == GLFW_TRUE;
+            game->requestRedraw();
+        } });
+}
+
+void Game::setupInput()
+{
+    // Installed before ImGui's backend, which keeps these and chains to them
+    // from its own callbacks.
+    glfwSetKeyCallback(window, [](GLFWwindow *window, int key, int scancode, int action, int mods)
+                       {
+        if (Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window)))
+        {
+            InputEvent event;
+            event.type = InputEventType::Key;
+            event.action = static_cast<InputAction>(action);
+            event.code = key;
+            event.mods = mods;
+            event.time = glfwGetTime();
+            game->input.push(event);
+        } });
+
+    glfwSetMouseButtonCallback(window, [](GLFWwindow *window, int button, int action, int mods)
+                               {
+        if (Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window)))
+        {
+            double x = 0.0, y = 0.0;
+            glfwGetCursorPos(window, &x, &y);
+
+            InputEvent event;
+            event.type = InputEventType::MouseButton;
+            event.action = static_cast<InputAction>(action);
+            event.code = button;
+            event.mods = mods;
+            event.x = static_cast<float>(x);
+            event.y = static_cast<float>(y);
+            event.time = glfwGetTime();
+            game->input.push(event);
+        } });
+
+    glfwSetCursorPosCallback(window, [](GLFWwindow *window, double x, double y)
+                             {
+        if (Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window)))
+        {
+            InputEvent event;
+            event.type = InputEventType::CursorMove;
+            event.x = static_cast<float>(x);
+            event.y = static_cast<float>(y);
+            event.time = glfwGetTime();
+            game->input.push(event);
+        } });
+
+    glfwSetScrollCallback(window, [](GLFWwindow *window, double xOffset, double yOffset)
+                          {
+        if (Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window)))
+        {
+            InputEvent event;
+            event.type = InputEventType::Scroll;
+            event.x = static_cast<float>(xOffset);
+            event.y = static_cast<float>(yOffset);
+            event.time = glfwGetTime();
+            game->input.push(event);
+        } });
 }
 
 void Game::setupGlad()
@@ -66,60 +433,201 @@ void Game::setupGlad()
         throw std::runtime_error("Failed to setup GLAD");
 }
 
-void Game::initialize()
+void Game::initialize(GameBackend backend)
 {
     srand(static_cast<unsigned int>(time(nullptr)));
 
-    setupGLFW(800, 600);
+    this->backend = backend;
+
+    // The main thread joins in while it waits, so one core is left for it.
+    jobSystem = std::make_unique<JobSystem>(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    stateStack.setJobSystem(jobSystem.get());
+
+    // Headless runs are tests and soak runs; they neither read nor
+    // overwrite the player's settings.
+    settings = std::make_unique<SettingsStore>(backend == GameBackend::Headless ? "" : SettingsStore::getDefaultPath());
+    const Settings &startupSettings = settings->get();
+    framePacer.setMode(startupSettings.presentMode);
+    framePacer.setFrameRateCap(startupSettings.frameRateCap);
+    framePacer.setLateLatchEnabled(startupSettings.lateLatch);
+
+    if (backend == GameBackend::Headless)
+    {
+        imGuiManager = std::make_unique<ImGuiManager>(nullptr, 800, 600);
+        stateStack.setProfiler(&profiler);
+        profilerOverlay = std::make_unique<ProfilerOverlayState>(*this, profiler, *imGuiManager);
+
+        // Splash and loading need textures, so start straight at gameplay.
+        stateStack.push(std::make_unique<PlayState>(*this));
+        return;
+    }
+
+    setupGLFW(startupSettings);
 
     setupGlad();
 
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    imGuiManager = std::make_unique<ImGuiManager>(window, 800, 600);
+    setupInput();
+    imGuiManager = std::make_unique<ImGuiManager>(window, framebufferWidth, framebufferHeight);
+    spriteRenderer = std::make_unique<SpriteRenderer>();
+
+    gpuProfiler = std::make_unique<GpuProfiler>(profiler);
+    stateStack.setProfiler(&profiler);
+    profilerOverlay = std::make_unique<ProfilerOverlayState>(*this, profiler, *imGuiManager);
+
+    textureLoader = std::make_unique<TextureLoader>(
+        std::max(2u, std::thread::hardware_concurrency() / 2));
+    textureCache = std::make_unique<TextureCache>(*textureLoader);
+
+    // Prefer the copy the cook_assets target left in the build directory.
+    std::string splashLogoPath = "../../assets/textures/man_on_a_beach_logo.jpg";
+#if defined(GAMESTATE_COOKED_DIR)
+    if (std::filesystem::exists(GAMESTATE_COOKED_DIR "/textures/man_on_a_beach_logo.gtex"))
+        splashLogoPath = GAMESTATE_COOKED_DIR "/textures/man_on_a_beach_logo.gtex";
+#endif
+
+    AssetManifest manifest;
+    manifest.textures.push_back({"splashLogo", splashLogoPath});
 
-    stateStack.push(std::make_unique<LoadingState>(*this));
+    stateStack.push(std::make_unique<LoadingState>(
+        *this,
+        std::move(manifest),
+        [this](LoadedAssets assets)
+        {
+            return std::make_unique<SplashState>(*this, 3.0f, assets.getTexture("splashLogo"));
+        }));
 }
 
 void Game::update(float deltaTime)
 {
+    ProfileScope profileScope(&profiler, "Game", "update");
+
     stateStack.update(deltaTime);
 
+    if (profiler.isEnabled())
+        profilerOverlay->update(deltaTime);
+
     if (stateStack.isEmpty())
-        glfwSetWindowShouldClose(window, true);
+        requestClose();
+}
+
+void Game::render(float alpha)
+{
+    ProfileScope profileScope(&profiler, "Game", "render");
+
+    if (renderThread)
+    {
+        buildFrame(alpha);
+
+        ProfileScope captureScope(&profiler, "ImGuiManager", "captureFrame");
+        FrameSnapshot &snapshot = renderThread->getWriteSnapshot();
+        std::swap(snapshot.sprites, spriteBatch);
+        imGuiManager->captureFrame(snapshot.ui);
+        return;
+    }
+
+    GpuProfileScope gpuProfileScope(gpuProfiler.get(), "Game", "render");
+
+    if (backend == GameBackend::Windowed)
+    {
+        glClearColor(0.1f, 0.12f, 0.15f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        textureLoader->processUploads(textureUploadBudget);
+    }
+
+    buildFrame(alpha);
+
+    if (spriteRenderer)
+    {
+        ProfileScope spritesScope(&profiler, "SpriteRenderer", "render");
+        GpuProfileScope gpuSpritesScope(gpuProfiler.get(), "SpriteRenderer", "render");
+        spriteRenderer->render(spriteBatch);
+    }
+
+    {
+        ProfileScope renderFrameScope(&profiler, "ImGuiManager", "renderFrame");
+        GpuProfileScope gpuRenderFrameScope(gpuProfiler.get(), "ImGuiManager", "renderFrame");
+        imGuiManager->renderFrame();
+    }
+
+    if (textureCache)
+        textureCache->trim();
+}
+
+void Game::buildFrame(float alpha)
+{
+    {
+        ProfileScope newFrameScope(&profiler, "ImGuiManager", "newFrame");
+        imGuiManager->newFrame();
+    }
+
+    ImVec2 uiDimensions = imGuiManager->getUiDimensions();
+    spriteBatch.begin(glm::vec2(uiDimensions.x, uiDimensions.y), glm::ivec2(framebufferWidth, framebufferHeight));
+
+    stateStack.render(alpha);
+
+    if (profiler.isEnabled())
+        profilerOverlay->render(alpha);
+
+    spriteBatch.end();
 }
 
-void Game::render()
+// Runs on the render thread, which owns the GL context while pipelined.
+void Game::drawSnapshot(FrameSnapshot &snapshot)
 {
     glClearColor(0.1f, 0.12f, 0.15f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    imGuiManager->newFrame();
+    textureLoader->processUploads(textureUploadBudget);
 
-    stateStack.render();
+    // Sprites are the world; the UI goes on top.
+    spriteRenderer->render(snapshot.sprites);
+    imGuiManager->renderSnapshot(snapshot.ui);
 
-    imGuiManager->renderFrame();
+    // Only once the snapshot is drawn, so nothing it uses is released first.
+    textureCache->trim();
+    applySwapInterval();
+    glfwSwapBuffers(window);
 }
 
 void Game::resize(int width, int height)
 {
+    // Minimizing reports a 0x0 framebuffer; keep the last real size.
+    if (width <= 0 || height <= 0)
+        return;
+
+    framebufferWidth = width;
+    framebufferHeight = height;
     imGuiManager->resize(width, height);
+
+    // Remembered in window coordinates, which is what glfwCreateWindow
+    // takes; the framebuffer can be larger on high DPI displays.
+    if (!window || glfwGetWindowMonitor(window))
+        return;
+
+    int windowWidth = 0, windowHeight = 0;
+    glfwGetWindowSize(window, &windowWidth, &windowHeight);
+    const Settings &current = settings->get();
+    if (windowWidth != current.windowWidth || windowHeight != current.windowHeight)
+        settings->modify([windowWidth, windowHeight](Settings &settings)
+                         {
+                             settings.windowWidth = windowWidth;
+                             settings.windowHeight = windowHeight; });
 }
 
 std::unique_ptr<GameState> Game::makeOptionsState()
 {
-    auto optionsState = std::make_unique<OptionsState>(*this);
-    optionsState->onFullscreenToggled.connect(
-        [this](bool fullscreen)
-        {
-            setFullscreen(fullscreen);
-        });
-    return std::move(optionsState);
+    return std::make_unique<OptionsState>(*this);
 }
 
 void Game::setFullscreen(bool fullscreen)
 {
+    if (!window)
+        return;
+
     if (fullscreen)
     {
         GLFWmonitor *monitor = glfwGetPrimaryMonitor();
@@ -133,16 +641,113 @@ void Game::setFullscreen(bool fullscreen)
     }
     else
     {
+        const Settings &current = getSettings().get();
         glfwSetWindowMonitor(
             window,
             nullptr,
             100, 100,
-            800, 600,
+            current.windowWidth, current.windowHeight,
             0);
     }
 }
 
+GameBackend Game::getBackend() const
+{
+    return backend;
+}
+
 StateStack &Game::getStateStack()
 {
     return stateStack;
+}
+
+TextureLoader &Game::getTextureLoader()
+{
+    if (!textureLoader)
+        throw std::runtime_error("Game: getTextureLoader called before initialize or in headless mode");
+
+    return *textureLoader;
+}
+
+TextureCache &Game::getTextureCache()
+{
+    if (!textureCache)
+        throw std::runtime_error("Game: getTextureCache called before initialize or in headless mode");
+
+    return *textureCache;
+}
+
+JobSystem &Game::getJobSystem()
+{
+    if (!jobSystem)
+        throw std::runtime_error("Game: getJobSystem called before initialize");
+
+    return *jobSystem;
+}
+
+FramePacer &Game::getFramePacer()
+{
+    return framePacer;
+}
+
+SpriteBatch &Game::getSpriteBatch()
+{
+    return spriteBatch;
+}
+
+ImGuiManager &Game::getImGuiManager()
+{
+    if (!imGuiManager)
+        throw std::runtime_error("Game: getImGuiManager called before initialize");
+
+    return *imGuiManager;
+}
+
+InputSystem &Game::getInput()
+{
+    return input;
+}
+
+EventBus &Game::getEvents()
+{
+    return events;
+}
+
+SettingsStore &Game::getSettings()
+{
+    if (!settings)
+        throw std::runtime_error("Game: getSettings called before initialize");
+
+    return *settings;
+}
+
+FixedTimestep &Game::getFixedTimestep()
+{
+    return fixedTimestep;
+}
+
+void Game::setFixedTimestepEnabled(bool enabled)
+{
+    fixedTimestepEnabled = enabled;
+    fixedTimestep.reset();
+}
+
+Profiler &Game::getProfiler()
+{
+    return profiler;
+}
+
+void Game::setProfilerEnabled(bool enabled)
+{
+    profiler.setEnabled(enabled);
+}
+
+void Game::setPipelinedRendering(bool enabled)
+{
+    pipelinedRendering = enabled;
+}
+
+bool Game::isPipelinedRendering() const
+{
+    return pipelinedRendering;
 }
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include "core/mapped_file.hpp"
+#include "game/settings.hpp"
+
+namespace
+{
+    constexpr const char *presentModeNames[] = {"vsync", "adaptive_vsync", "uncapped", "capped"};
+
+    std::string_view trim(std::string_view text)
+    {
+        const char *whitespace = " \t\r";
+        size_t first = text.find_first_not_of(whitespace);
+        if (first == std::string_view::npos)
+            return {};
+
+        size_t last = text.find_last_not_of(whitespace);
+        return text.substr(first, last - first + 1);
+    }
+
+    template <typename Number>
+    bool parseNumber(std::string_view value, Number &result)
+    {
+        Number parsed{};
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+        if (error != std::errc() || end != value.data() + value.size() || !(parsed > 0))
+            return false;
+
+        result = parsed;
+        return true;
+    }
+
+    void parseBool(std::string_view value, bool &result)
+    {
+        if (value == "true" || value == "1")
+            result = true;
+        else if (value == "false" || value == "0")
+            result = false;
+    }
+
+    void apply(Settings &settings, std::string_view section, std::string_view key, std::string_view value)
+    {
+        if (section == "display")
+        {
+            if (key == "fullscreen")
+                parseBool(value, settings.fullscreen);
+            else if (key == "width")
+                parseNumber(value, settings.windowWidth);
+            else if (key == "height")
+                parseNumber(value, settings.windowHeight);
+        }
+        else if (section == "frame_pacing")
+        {
+            if (key == "present_mode")
+            {
+                for (size_t i = 0; i < std::size(presentModeNames); ++i)
+                {
+                    if (value == presentModeNames[i])
+                        settings.presentMode = static_cast<PresentMode>(i);
+                }
+            }
+            else if (key == "frame_rate_cap")
+            {
+                parseNumber(value, settings.frameRateCap);
+            }
+            else if (key == "late_latch")
+            {
+                parseBool(value, settings.lateLatch);
+            }
+        }
+    }
+}
+
+Settings Settings::parse(std::string_view text)
+{
+    Settings settings;
+    std::string_view section;
+    while (!text.empty())
+    {
+        size_t lineEnd = text.find('\n');
+        std::string_view line = trim(text.substr(0, lineEnd));
+        text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+
+        if (line.empty() || line.front() == ';' || line.front() == '#')
+            continue;
+
+        if (line.front() == '[' && line.back() == ']')
+        {
+            section = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals != std::string_view::npos)
+            apply(settings, section, trim(line.substr(0, equals)), trim(line.substr(equals + 1)));
+    }
+    return settings;
+}
+
+std::string Settings::serialize() const
+{
+    std::ostringstream out;
+    out << std::boolalpha
+        << "[display]\n"
+        << "fullscreen = " << fullscreen << "\n"
+        << "width = " << windowWidth << "\n"
+        << "height = " << windowHeight << "\n"
+        << "\n"
+        << "[frame_pacing]\n"
+        << "present_mode = " << presentModeNames[static_cast<size_t>(presentMode)] << "\n"
+        << "frame_rate_cap = " << frameRateCap << "\n"
+        << "late_latch = " << lateLatch << "\n";
+    return out.str();
+}
+
+SettingsStore::SettingsStore(std::string filePath, std::chrono::milliseconds writeDelay)
+    : filePath(std::move(filePath)), writeDelay(writeDelay)
+{
+    if (this->filePath.empty())
+        return;
+
+    // Like a bad write, a file that cannot be read must not stop the game;
+    // it starts with the defaults instead.
+    std::error_code error;
+    if (std::filesystem::exists(this->filePath, error))
+    {
+        try
+        {
+            MappedFile file(this->filePath);
+            settings = Settings::parse(std::string_view(reinterpret_cast<const char *>(file.data()), file.size()));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "SettingsStore: failed to load " << this->filePath << ": " << e.what() << std::endl;
+        }
+    }
+
+    writer = std::thread(&SettingsStore::writerLoop, this);
+}
+
+SettingsStore::~SettingsStore()
+{
+    if (!writer.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    // The writer saves whatever is still pending before it exits.
+    changed.notify_all();
+    writer.join();
+}
+
+const Settings &SettingsStore::get() const
+{
+    return settings;
+}
+
+void SettingsStore::modify(const std::function<void(Settings &)> &change)
+{
+    change(settings);
+    if (filePath.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingSettings = settings;
+        ++changeVersion;
+    }
+    changed.notify_all();
+}
+
+void SettingsStore::flush()
+{
+    if (filePath.empty())
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        flushRequested = true;
+        changed.notify_all();
+        written.wait(lock, [this]()
+                     { return writtenVersion == changeVersion; });
+        flushRequested = false;
+    }
+    rethrowWriteError();
+}
+
+const std::string &SettingsStore::getFilePath() const
+{
+    return filePath;
+}
+
+size_t SettingsStore::getWriteCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return writeCount;
+}
+
+std::string SettingsStore::getDefaultPath()
+{
+    std::filesystem::path directory;
+#if defined(_WIN32)
+    if (const char *appData = std::getenv("APPDATA"); appData && *appData)
+        directory = std::filesystem::path(appData) / "gamestate";
+#else
+    if (const char *configHome = std::getenv("XDG_CONFIG_HOME"); configHome && *configHome)
+        directory = std::filesystem::path(configHome) / "gamestate";
+    else if (const char *home = std::getenv("HOME"); home && *home)
+        directory = std::filesystem::path(home) / ".config" / "gamestate";
+#endif
+    return (directory / "settings.ini").string();
+}
+
+void SettingsStore::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        changed.wait(lock, [this]()
+                     { return stopping || changeVersion != writtenVersion; });
+        if (changeVersion == writtenVersion)
+            return;
+
+        // Dragging a slider changes settings every frame; give the burst
+        // time to finish so it costs one write.
+        changed.wait_for(lock, writeDelay, [this]()
+                         { return stopping || flushRequested; });
+
+        Settings snapshot = pendingSettings;
+        uint64_t version = changeVersion;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+        {
+            write(snapshot);
+        }
+        catch (const std::exception &e)
+        {
+            // A settings file that cannot be saved must not stop the game.
+            std::cerr << "SettingsStore: failed to save " << filePath << ": " << e.what() << std::endl;
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        if (error)
+            writeError = error;
+        else
+            ++writeCount;
+        writtenVersion = version;
+        written.notify_all();
+    }
+}
+
+void SettingsStore::write(const Settings &snapshot)
+{
+    // Writing beside the file and renaming over it means a crash mid-write
+    // leaves the old settings rather than half of the new ones.
+    std::filesystem::path directory = std::filesystem::path(filePath).parent_path();
+    if (!directory.empty())
+        std::filesystem::create_directories(directory);
+
+    std::string temporaryPath = filePath + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        out << snapshot.serialize();
+        if (!out)
+            throw std::runtime_error("SettingsStore: failed to write " + temporaryPath);
+    }
+    std::filesystem::rename(temporaryPath, filePath);
+}
+
+void SettingsStore::rethrowWriteError()
+{
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::exchange(writeError, nullptr);
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
\ No newline at end of file
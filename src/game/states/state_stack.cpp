@@ -1,30 +1,163 @@
 #include <stdexcept>
+#include "core/job_system.hpp"
+#include "core/profiler.hpp"
 #include "game/states/state_stack.hpp"
 
+namespace
+{
+    struct DispatchScope
+    {
+        explicit DispatchScope(int &depth) : depth(depth) { ++depth; }
+        ~DispatchScope() { --depth; }
+
+        int &depth;
+    };
+
+    struct StateHooks
+    {
+        static void enter(std::unique_ptr<GameState> &state) { state->onEnter(); }
+        static void exit(std::unique_ptr<GameState> &state) { state->onExit(); }
+        static void pause(std::unique_ptr<GameState> &state) { state->onPause(); }
+        static void resume(std::unique_ptr<GameState> &state) { state->onResume(); }
+    };
+}
+
 void StateStack::push(std::unique_ptr<GameState> state)
 {
-    stack.clear();
-    stack.push_back(std::move(state));
+    if (!state)
+        throw std::runtime_error("StateStack: push received nullptr GameState");
+
+    requestChange(Action::Push, std::move(state));
 }
 
 void StateStack::pop()
 {
+    requestChange(Action::Pop, nullptr);
 }
 
 void StateStack::replace(std::unique_ptr<GameState> state)
 {
+    if (!state)
+        throw std::runtime_error("StateStack: replace received nullptr GameState");
+
+    requestChange(Action::Replace, std::move(state));
+}
+
+void StateStack::clear()
+{
+    // One batch, so the states exit top to bottom without any of them
+    // being resumed in between. A pop per pending change covers the pushes
+    // those may add.
+    {
+        std::lock_guard lock(pendingMutex);
+        size_t pops = stack.size() + pendingChanges.size();
+        for (size_t i = 0; i < pops; ++i)
+            pendingChanges.push_back({Action::Pop, nullptr});
+    }
+    applyPendingChanges();
 }
 
 void StateStack::update(float deltaTime)
 {
-    if (!stack.empty())
-        top().update(deltaTime);
+    {
+        DispatchScope scope(dispatchDepth);
+        if (parallelUpdates.empty())
+        {
+            updateSerially(deltaTime);
+        }
+        else
+        {
+            // Parallel-safe states tick on the workers while the rest run here
+            // in stack order. The wait is the barrier before anything renders,
+            // so it has to happen even if a serial update throws. The profiler
+            // is not thread-safe, so the parallel states are timed as a whole.
+            ProfileScope profileScope(profiler, "StateStack", "parallelUpdate");
+            JobGroup group;
+            for (GameState *state : parallelUpdates)
+                jobSystem->run(group, [state, deltaTime]()
+                               { state->update(deltaTime); });
+
+            try
+            {
+                updateSerially(deltaTime);
+            }
+            catch (...)
+            {
+                jobSystem->wait(group);
+                throw;
+            }
+            jobSystem->wait(group);
+        }
+    }
+
+    applyPendingChanges();
+}
+
+void StateStack::updateSerially(float deltaTime)
+{
+    for (GameState *state : serialUpdates)
+    {
+        ProfileScope profileScope(profiler, state->getName(), "update");
+        state->update(deltaTime);
+    }
+}
+
+void StateStack::render(float alpha)
+{
+    {
+        DispatchScope scope(dispatchDepth);
+        for (size_t i = firstVisible; i < stack.size(); ++i)
+        {
+            ProfileScope profileScope(profiler, stack[i]->getName(), "render");
+            stack[i]->render(alpha);
+        }
+    }
+
+    // ImGui buttons act from render, so their transitions land before the
+    // next frame rather than after its update.
+    applyPendingChanges();
 }
 
-void StateStack::render()
+bool StateStack::handleInput(const InputEvent &event)
 {
-    for (auto &state : stack)
-        state->render();
+    bool consumed = false;
+    {
+        DispatchScope scope(dispatchDepth);
+        for (size_t i = stack.size(); i > firstInputReceiver && !consumed; --i)
+            consumed = stack[i - 1]->handleInput(event);
+    }
+
+    applyPendingChanges();
+    return consumed;
+}
+
+void StateStack::applyPendingChanges()
+{
+    if (dispatchDepth > 0 || !hasPendingChanges())
+        return;
+
+    DispatchScope scope(dispatchDepth);
+    while (true)
+    {
+        {
+            std::lock_guard lock(pendingMutex);
+            if (pendingChanges.empty())
+                break;
+
+            applyingChanges.clear();
+            applyingChanges.swap(pendingChanges);
+        }
+        StackTransitions::apply<StateHooks>(stack, applyingChanges, pushes);
+    }
+    applyingChanges.clear();
+
+    refreshCoverage();
+}
+
+bool StateStack::hasPendingChanges() const
+{
+    std::lock_guard lock(pendingMutex);
+    return !pendingChanges.empty();
 }
 
 bool StateStack::isEmpty() const
@@ -43,4 +176,69 @@ GameState &StateStack::top() const
         throw std::runtime_error("StateStack: top called on empty stack");
 
     return *stack.back();
+}
+
+bool StateStack::needsContinuousUpdates() const
+{
+    // Asked every frame rather than sampled with the coverage, so a state
+    // that becomes dirty can wake the game without a transition.
+    for (const auto *updates : {&serialUpdates, &parallelUpdates})
+    {
+        for (const GameState *state : *updates)
+        {
+            if (state->needsContinuousUpdates())
+                return true;
+        }
+    }
+    return false;
+}
+
+void StateStack::setProfiler(Profiler *profiler)
+{
+    this->profiler = profiler;
+}
+
+void StateStack::setJobSystem(JobSystem *jobSystem)
+{
+    this->jobSystem = jobSystem;
+    refreshCoverage();
+}
+
+void StateStack::requestChange(Action action, std::unique_ptr<GameState> state)
+{
+    // Parallel updates may request changes from worker threads. Their order
+    // within the batch is then whatever order the workers got there in.
+    {
+        std::lock_guard lock(pendingMutex);
+        pendingChanges.push_back({action, std::move(state)});
+    }
+
+    // Outside of update/render there is nobody to pull the rug from under,
+    // so the change lands straight away. Inside, it waits for the batch.
+    applyPendingChanges();
+}
+
+void StateStack::refreshCoverage()
+{
+    // Opacity and covered updates are sampled once per batch rather than
+    // every frame, so hidden states cost nothing until the stack changes.
+    firstVisible = StackTransitions::findTopmost(stack, [](const auto &state)
+                                                 { return state->isOpaque(); });
+    firstInputReceiver = StackTransitions::findTopmost(stack, [](const auto &state)
+                                                       { return state->blocksInput(); });
+
+    serialUpdates.clear();
+    parallelUpdates.clear();
+    for (size_t i = 0; i < stack.size(); ++i)
+    {
+        GameState *state = stack[i].get();
+        bool isTop = i + 1 == stack.size();
+        if (!isTop && !state->updatesWhenCovered())
+            continue;
+
+        if (jobSystem && state->isParallelUpdateSafe())
+            parallelUpdates.push_back(state);
+        else
+            serialUpdates.push_back(state);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <GLFW/glfw3.h>
+#include <cmath>
+#include "input/input_system.hpp"
+
+static_assert(static_cast<int>(InputAction::Release) == GLFW_RELEASE);
+static_assert(static_cast<int>(InputAction::Press) == GLFW_PRESS);
+static_assert(static_cast<int>(InputAction::Repeat) == GLFW_REPEAT);
+static_assert(InputKey::Space == GLFW_KEY_SPACE);
+static_assert(InputKey::Escape == GLFW_KEY_ESCAPE);
+static_assert(InputKey::F3 == GLFW_KEY_F3);
+static_assert(InputSystem::maxGamepads == GLFW_JOYSTICK_LAST + 1);
+static_assert(InputSystem::gamepadButtonCount == GLFW_GAMEPAD_BUTTON_LAST + 1);
+static_assert(InputSystem::gamepadAxisCount == GLFW_GAMEPAD_AXIS_LAST + 1);
+
+namespace
+{
+    // Sticks jitter by a few thousandths at rest; anything below this is not
+    // worth an event.
+    constexpr float axisThreshold = 0.01f;
+}
+
+InputSystem::InputSystem(size_t capacity)
+    : events(capacity)
+{
+}
+
+void InputSystem::push(const InputEvent &event)
+{
+    if (!events.tryPush(event))
+        ++droppedCount;
+}
+
+void InputSystem::pollGamepads(double time)
+{
+    for (int gamepad = 0; gamepad < static_cast<int>(maxGamepads); ++gamepad)
+    {
+        GamepadState &previous = gamepads[gamepad];
+        GLFWgamepadstate current;
+        if (!glfwJoystickIsGamepad(gamepad) || !glfwGetGamepadState(gamepad, &current))
+        {
+            previous = GamepadState{};
+            continue;
+        }
+
+        InputEvent event;
+        event.gamepad = gamepad;
+        event.time = time;
+
+        // A newly connected pad reports what is already held, not a press.
+        bool reportChanges = previous.connected;
+        previous.connected = true;
+
+        event.type = InputEventType::GamepadButton;
+        for (size_t button = 0; button < gamepadButtonCount; ++button)
+        {
+            if (current.buttons[button] == previous.buttons[button])
+                continue;
+
+            previous.buttons[button] = current.buttons[button];
+            if (!reportChanges)
+                continue;
+
+            event.code = static_cast<int>(button);
+            event.action = current.buttons[button] == GLFW_PRESS ? InputAction::Press : InputAction::Release;
+            push(event);
+        }
+
+        event.type = InputEventType::GamepadAxis;
+        event.action = InputAction::Repeat;
+        for (size_t axis = 0; axis < gamepadAxisCount; ++axis)
+        {
+            if (std::abs(current.axes[axis] - previous.axes[axis]) < axisThreshold)
+                continue;
+
+            previous.axes[axis] = current.axes[axis];
+            if (!reportChanges)
+                continue;
+
+            event.code = static_cast<int>(axis);
+            event.x = current.axes[axis];
+            push(event);
+        }
+    }
+}
+
+bool InputSystem::pop(InputEvent &event)
+{
+    return events.tryPop(event);
+}
+
+size_t InputSystem::getPendingCount() const
+{
+    return events.size();
+}
+
+size_t InputSystem::getDroppedCount() const
+{
+    return droppedCount;
+}
\ No newline at end of file
@@ -1,13 +1,30 @@
 #include <iostream>
+#include <string>
 #include "game/game.hpp"
 
-int main()
+int main(int argc, char **argv)
 {
     try
     {
+        // gamestate --headless [ticks] runs the state logic without a window;
+        // gamestate --pipelined renders on a separate thread.
+        GameBackend backend = GameBackend::Windowed;
+        size_t tickLimit = 0;
+        bool pipelined = false;
+        if (argc > 1 && std::string(argv[1]) == "--headless")
+        {
+            backend = GameBackend::Headless;
+            tickLimit = argc > 2 ? std::stoull(argv[2]) : 60 * 60;
+        }
+        else if (argc > 1 && std::string(argv[1]) == "--pipelined")
+        {
+            pipelined = true;
+        }
+
         Game game;
-        game.initialize();
-        game.run();
+        game.initialize(backend);
+        game.setPipelinedRendering(pipelined);
+        game.run(tickLimit);
     }
     catch (const std::exception &e)
     {
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include "rendering/atlas_layout.hpp"
+#include "rendering/rect_packer.hpp"
+
+namespace
+{
+    void blitWithExtrusion(std::vector<unsigned char> &pixels, int pageSize, const AtlasSource &source, int x, int y, int padding)
+    {
+        // Copy the image and smear its border into the padding so bilinear
+        // sampling at the edge of a frame never picks up its neighbour.
+        for (int row = -padding; row < source.height + padding; ++row)
+        {
+            int sourceRow = std::clamp(row, 0, source.height - 1);
+            for (int column = -padding; column < source.width + padding; ++column)
+            {
+                int sourceColumn = std::clamp(column, 0, source.width - 1);
+                const unsigned char *from = source.rgbaPixels + (static_cast<size_t>(sourceRow) * source.width + sourceColumn) * 4;
+                unsigned char *to = pixels.data() + (static_cast<size_t>(y + row) * pageSize + x + column) * 4;
+                std::memcpy(to, from, 4);
+            }
+        }
+    }
+}
+
+AtlasLayout::AtlasLayout(const std::vector<AtlasSource> &sources, int pageSize, int padding)
+    : pageSize(pageSize)
+{
+    if (pageSize <= 0)
+        throw std::invalid_argument("AtlasLayout: pageSize must be positive");
+    if (padding < 0)
+        throw std::invalid_argument("AtlasLayout: padding must not be negative");
+
+    // Tallest first packs noticeably tighter on a skyline.
+    std::vector<uint32_t> order(sources.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sources](uint32_t a, uint32_t b)
+                     { return sources[a].height > sources[b].height; });
+
+    uvRects.resize(sources.size());
+    framePages.resize(sources.size());
+    std::vector<RectPacker> packers;
+    const float texel = 1.0f / pageSize;
+
+    for (uint32_t frame : order)
+    {
+        const AtlasSource &source = sources[frame];
+        if (source.width <= 0 || source.height <= 0 || !source.rgbaPixels)
+            throw std::invalid_argument("AtlasLayout: source " + source.name + " has no pixels");
+        if (!frameIndices.emplace(source.name, frame).second)
+            throw std::invalid_argument("AtlasLayout: duplicate source " + source.name);
+
+        int paddedWidth = source.width + padding * 2,
+            paddedHeight = source.height + padding * 2;
+        if (paddedWidth > pageSize || paddedHeight > pageSize)
+            throw std::invalid_argument("AtlasLayout: source " + source.name + " does not fit in a page");
+
+        PackedRect packed;
+        size_t page = 0;
+        while (page < packers.size() && !packers[page].pack(paddedWidth, paddedHeight, packed))
+            ++page;
+
+        if (page == packers.size())
+        {
+            if (packers.size() > UINT16_MAX)
+                throw std::runtime_error("AtlasLayout: too many pages");
+
+            packers.emplace_back(pageSize, pageSize);
+            pagePixels.emplace_back(static_cast<size_t>(pageSize) * pageSize * 4, 0);
+            packers.back().pack(paddedWidth, paddedHeight, packed);
+        }
+
+        int x = packed.x + padding,
+            y = packed.y + padding;
+        blitWithExtrusion(pagePixels[page], pageSize, source, x, y, padding);
+
+        uvRects[frame] = {glm::vec2(x * texel, y * texel),
+                          glm::vec2((x + source.width) * texel, (y + source.height) * texel)};
+        framePages[frame] = static_cast<uint16_t>(page);
+    }
+}
+
+uint32_t AtlasLayout::getFrameIndex(const std::string &name) const
+{
+    auto it = frameIndices.find(name);
+    if (it == frameIndices.end())
+        throw std::runtime_error("AtlasLayout: no frame named " + name);
+
+    return it->second;
+}
+
+size_t AtlasLayout::getFrameCount() const
+{
+    return uvRects.size();
+}
+
+const UVRect &AtlasLayout::getUV(uint32_t frame) const
+{
+    if (frame >= uvRects.size())
+        throw std::out_of_range("AtlasLayout: frame index out of range");
+
+    return uvRects[frame];
+}
+
+uint16_t AtlasLayout::getPage(uint32_t frame) const
+{
+    if (frame >= framePages.size())
+        throw std::out_of_range("AtlasLayout: frame index out of range");
+
+    return framePages[frame];
+}
+
+void AtlasLayout::getUVs(std::span<const uint32_t> frames, std::span<UVRect> uvs) const
+{
+    if (uvs.size() < frames.size())
+        throw std::invalid_argument("AtlasLayout: getUVs output is smaller than frames");
+
+    const UVRect *table = uvRects.data();
+    const uint32_t frameCount = static_cast<uint32_t>(uvRects.size());
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        if (frames[i] >= frameCount)
+            throw std::out_of_range("AtlasLayout: frame index out of range");
+
+        uvs[i] = table[frames[i]];
+    }
+}
+
+int AtlasLayout::getPageSize() const
+{
+    return pageSize;
+}
+
+size_t AtlasLayout::getPageCount() const
+{
+    return pagePixels.size();
+}
+
+std::span<const unsigned char> AtlasLayout::getPagePixels(size_t page) const
+{
+    if (page >= pagePixels.size())
+        throw std::out_of_range("AtlasLayout: page index out of range");
+
+    return pagePixels[page];
+}
+
+void AtlasLayout::releasePixels()
+{
+    for (auto &pixels : pagePixels)
+    {
+        pixels.clear();
+        pixels.shrink_to_fit();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include "rendering/block_compression.hpp"
+
+namespace
+{
+    uint16_t packRGB565(const unsigned char *rgb)
+    {
+        return static_cast<uint16_t>(((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+    }
+
+    void unpackRGB565(uint16_t color, unsigned char *rgb)
+    {
+        unsigned char r = (color >> 11) & 0x1F,
+                      g = (color >> 5) & 0x3F,
+                      b = color & 0x1F;
+        rgb[0] = static_cast<unsigned char>((r << 3) | (r >> 2));
+        rgb[1] = static_cast<unsigned char>((g << 2) | (g >> 4));
+        rgb[2] = static_cast<unsigned char>((b << 3) | (b >> 2));
+    }
+
+    int colorDistance(const unsigned char *a, const unsigned char *b)
+    {
+        int dr = a[0] - b[0], dg = a[1] - b[1], db = a[2] - b[2];
+        return dr * dr + dg * dg + db * db;
+    }
+
+    void writeColorBlock(const unsigned char *rgbaBlock, unsigned char *output)
+    {
+        // Range fit on the colour bounding box, inset by 1/16 so the
+        // endpoints are not wasted on a couple of outliers.
+        unsigned char minColor[3] = {255, 255, 255}, maxColor[3] = {0, 0, 0};
+        for (int i = 0; i < 16; ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                minColor[c] = std::min(minColor[c], rgbaBlock[i * 4 + c]);
+                maxColor[c] = std::max(maxColor[c], rgbaBlock[i * 4 + c]);
+            }
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+            int inset = (maxColor[c] - minColor[c]) >> 4;
+            minColor[c] = static_cast<unsigned char>(minColor[c] + inset);
+            maxColor[c] = static_cast<unsigned char>(maxColor[c] - inset);
+        }
+
+        uint16_t color0 = packRGB565(maxColor),
+                 color1 = packRGB565(minColor);
+        if (color0 < color1)
+            std::swap(color0, color1);
+
+        unsigned char palette[4][3];
+        unpackRGB565(color0, palette[0]);
+        unpackRGB565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = static_cast<unsigned char>((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = static_cast<unsigned char>((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+
+        // Equal endpoints put a BC1 decoder in three-colour mode, but index 0
+        // is still the exact colour there, so every pixel just uses it.
+        uint32_t indices = 0;
+        if (color0 != color1)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                int best = 0, bestDistance = colorDistance(rgbaBlock + i * 4, palette[0]);
+                for (int p = 1; p < 4; ++p)
+                {
+                    int distance = colorDistance(rgbaBlock + i * 4, palette[p]);
+                    if (distance < bestDistance)
+                    {
+                        best = p;
+                        bestDistance = distance;
+                    }
+                }
+                indices |= static_cast<uint32_t>(best) << (i * 2);
+            }
+        }
+
+        output[0] = static_cast<unsigned char>(color0 & 0xFF);
+        output[1] = static_cast<unsigned char>(color0 >> 8);
+        output[2] = static_cast<unsigned char>(color1 & 0xFF);
+        output[3] = static_cast<unsigned char>(color1 >> 8);
+        for (int i = 0; i < 4; ++i)
+            output[4 + i] = static_cast<unsigned char>((indices >> (i * 8)) & 0xFF);
+    }
+
+    void readColorBlock(const unsigned char *input, unsigned char *rgbaBlock, bool allowTransparentMode)
+    {
+        uint16_t color0 = static_cast<uint16_t>(input[0] | (input[1] << 8)),
+                 color1 = static_cast<uint16_t>(input[2] | (input[3] << 8));
+        uint32_t indices = input[4] | (input[5] << 8) | (input[6] << 16) | (static_cast<uint32_t>(input[7]) << 24);
+
+        unsigned char palette[4][4];
+        unpackRGB565(color0, palette[0]);
+        unpackRGB565(color1, palette[1]);
+        palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+        if (color0 > color1 || !allowTransparentMode)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                palette[2][c] = static_cast<unsigned char>((2 * palette[0][c] + palette[1][c]) / 3);
+                palette[3][c] = static_cast<unsigned char>((palette[0][c] + 2 * palette[1][c]) / 3);
+            }
+        }
+        else
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                palette[2][c] = static_cast<unsigned char>((palette[0][c] + palette[1][c]) / 2);
+                palette[3][c] = 0;
+            }
+            palette[3][3] = 0;
+        }
+
+        for (int i = 0; i < 16; ++i)
+            std::memcpy(rgbaBlock + i * 4, palette[(indices >> (i * 2)) & 0x3], 4);
+    }
+
+    void writeAlphaBlock(const unsigned char *rgbaBlock, unsigned char *output)
+    {
+        unsigned char alpha0 = 0, alpha1 = 255;
+        for (int i = 0; i < 16; ++i)
+        {
+            alpha0 = std::max(alpha0, rgbaBlock[i * 4 + 3]);
+            alpha1 = std::min(alpha1, rgbaBlock[i * 4 + 3]);
+        }
+
+        unsigned char palette[8] = {alpha0, alpha1};
+        for (int i = 1; i < 7; ++i)
+            palette[i + 1] = static_cast<unsigned char>(((7 - i) * alpha0 + i * alpha1) / 7);
+
+        uint64_t indices = 0;
+        if (alpha0 != alpha1)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                int alpha = rgbaBlock[i * 4 + 3];
+                int best = 0, bestDistance = 256;
+                for (int p = 0; p < 8; ++p)
+                {
+                    int distance = std::abs(alpha - palette[p]);
+                    if (distance < bestDistance)
+                    {
+                        best = p;
+                        bestDistance = distance;
+                    }
+                }
+                indices |= static_cast<uint64_t>(best) << (i * 3);
+            }
+        }
+
+        output[0] = alpha0;
+        output[1] = alpha1;
+        for (int i = 0; i < 6; ++i)
+            output[2 + i] = static_cast<unsigned char>((indices >> (i * 8)) & 0xFF);
+    }
+
+    void readAlphaBlock(const unsigned char *input, unsigned char *rgbaBlock)
+    {
+        unsigned char palette[8] = {input[0], input[1]};
+        if (input[0] > input[1])
+        {
+            for (int i = 1; i < 7; ++i)
+                palette[i + 1] = static_cast<unsigned char>(((7 - i) * input[0] + i * input[1]) / 7);
+        }
+        else
+        {
+            for (int i = 1; i < 5; ++i)
+                palette[i + 1] = static_cast<unsigned char>(((5 - i) * input[0] + i * input[1]) / 5);
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        uint64_t indices = 0;
+        for (int i = 0; i < 6; ++i)
+            indices |= static_cast<uint64_t>(input[2 + i]) << (i * 8);
+
+        for (int i = 0; i < 16; ++i)
+            rgbaBlock[i * 4 + 3] = palette[(indices >> (i * 3)) & 0x7];
+    }
+
+    template <typename EncodeBlock>
+    std::vector<unsigned char> compress(int width, int height, const unsigned char *rgbaPixels, size_t bytesPerBlock, EncodeBlock encodeBlock)
+    {
+        if (width <= 0 || height <= 0 || !rgbaPixels)
+            throw std::invalid_argument("compress received an empty image");
+
+        std::vector<unsigned char> blocks(getBlockCompressedSize(width, height, bytesPerBlock));
+        unsigned char rgbaBlock[64];
+        unsigned char *output = blocks.data();
+        for (int blockY = 0; blockY < height; blockY += 4)
+        {
+            for (int blockX = 0; blockX < width; blockX += 4)
+            {
+                // Edge blocks repeat the last row/column rather than encoding garbage.
+                for (int y = 0; y < 4; ++y)
+                {
+                    int sourceY = std::min(blockY + y, height - 1);
+                    for (int x = 0; x < 4; ++x)
+                    {
+                        int sourceX = std::min(blockX + x, width - 1);
+                        std::memcpy(rgbaBlock + (y * 4 + x) * 4, rgbaPixels + (static_cast<size_t>(sourceY) * width + sourceX) * 4, 4);
+                    }
+                }
+                encodeBlock(rgbaBlock, output);
+                output += bytesPerBlock;
+            }
+        }
+        return blocks;
+    }
+
+    template <typename DecodeBlock>
+    std::vector<unsigned char> decompress(int width, int height, const unsigned char *blocks, size_t bytesPerBlock, DecodeBlock decodeBlock)
+    {
+        if (width <= 0 || height <= 0 || !blocks)
+            throw std::invalid_argument("decompress received an empty image");
+
+        std::vector<unsigned char> rgbaPixels(static_cast<size_t>(width) * height * 4);
+        unsigned char rgbaBlock[64];
+        const unsigned char *input = blocks;
+        for (int blockY = 0; blockY < height; blockY += 4)
+        {
+            for (int blockX = 0; blockX < width; blockX += 4)
+            {
+                decodeBlock(input, rgbaBlock);
+                input += bytesPerBlock;
+                for (int y = 0; y < 4 && blockY + y < height; ++y)
+                {
+                    int columns = std::min(4, width - blockX);
+                    std::memcpy(rgbaPixels.data() + (static_cast<size_t>(blockY + y) * width + blockX) * 4, rgbaBlock + y * 16, columns * 4);
+                }
+            }
+        }
+        return rgbaPixels;
+    }
+}
+
+void encodeBC1Block(const unsigned char *rgbaBlock, unsigned char *output)
+{
+    writeColorBlock(rgbaBlock, output);
+}
+
+void encodeBC3Block(const unsigned char *rgbaBlock, unsigned char *output)
+{
+    writeAlphaBlock(rgbaBlock, output);
+    writeColorBlock(rgbaBlock, output + 8);
+}
+
+void decodeBC1Block(const unsigned char *input, unsigned char *rgbaBlock)
+{
+    readColorBlock(input, rgbaBlock, true);
+}
+
+void decodeBC3Block(const unsigned char *input, unsigned char *rgbaBlock)
+{
+    readColorBlock(input + 8, rgbaBlock, false);
+    readAlphaBlock(input, rgbaBlock);
+}
+
+std::vector<unsigned char> compressBC1(int width, int height, const unsigned char *rgbaPixels)
+{
+    return compress(width, height, rgbaPixels, 8, encodeBC1Block);
+}
+
+std::vector<unsigned char> compressBC3(int width, int height, const unsigned char *rgbaPixels)
+{
+    return compress(width, height, rgbaPixels, 16, encodeBC3Block);
+}
+
+std::vector<unsigned char> decompressBC1(int width, int height, const unsigned char *blocks)
+{
+    return decompress(width, height, blocks, 8, decodeBC1Block);
+}
+
+std::vector<unsigned char> decompressBC3(int width, int height, const unsigned char *blocks)
+{
+    return decompress(width, height, blocks, 16, decodeBC3Block);
+}
+
+size_t getBlockCompressedSize(int width, int height, size_t bytesPerBlock)
+{
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * bytesPerBlock;
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "rendering/block_compression.hpp"
+#include "rendering/cooked_texture.hpp"
+
+namespace
+{
+    std::vector<unsigned char> downsample(int width, int height, const std::vector<unsigned char> &rgbaPixels, int &nextWidth, int &nextHeight)
+    {
+        nextWidth = std::max(width / 2, 1);
+        nextHeight = std::max(height / 2, 1);
+        std::vector<unsigned char> next(static_cast<size_t>(nextWidth) * nextHeight * 4);
+        for (int y = 0; y < nextHeight; ++y)
+        {
+            int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+            for (int x = 0; x < nextWidth; ++x)
+            {
+                int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                for (int c = 0; c < 4; ++c)
+                {
+                    int sum = rgbaPixels[(static_cast<size_t>(y0) * width + x0) * 4 + c] +
+                              rgbaPixels[(static_cast<size_t>(y0) * width + x1) * 4 + c] +
+                              rgbaPixels[(static_cast<size_t>(y1) * width + x0) * 4 + c] +
+                              rgbaPixels[(static_cast<size_t>(y1) * width + x1) * 4 + c];
+                    next[(static_cast<size_t>(y) * nextWidth + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+        return next;
+    }
+
+    std::vector<unsigned char> encode(CookedTextureFormat format, int width, int height, const std::vector<unsigned char> &rgbaPixels)
+    {
+        switch (format)
+        {
+        case CookedTextureFormat::BC1:
+            return compressBC1(width, height, rgbaPixels.data());
+        case CookedTextureFormat::BC3:
+            return compressBC3(width, height, rgbaPixels.data());
+        default:
+            return rgbaPixels;
+        }
+    }
+}
+
+CookedTexture::CookedTexture(const std::string &filePath)
+    : file(filePath)
+{
+    parse(file.data(), file.size());
+}
+
+CookedTexture::CookedTexture(std::vector<unsigned char> bytes)
+    : ownedBytes(std::move(bytes))
+{
+    parse(ownedBytes.data(), ownedBytes.size());
+}
+
+std::vector<unsigned char> CookedTexture::cook(
+    int width, int height, const unsigned char *rgbaPixels,
+    CookedTextureFormat format, bool generateMips)
+{
+    if (width <= 0 || height <= 0 || !rgbaPixels)
+        throw std::invalid_argument("CookedTexture: cook received an empty image");
+
+    std::vector<std::vector<unsigned char>> payloads;
+    std::vector<CookedMipHeader> mipHeaders;
+    std::vector<unsigned char> level(rgbaPixels, rgbaPixels + static_cast<size_t>(width) * height * 4);
+    int levelWidth = width, levelHeight = height;
+    while (true)
+    {
+        payloads.push_back(encode(format, levelWidth, levelHeight, level));
+        mipHeaders.push_back({static_cast<uint32_t>(levelWidth), static_cast<uint32_t>(levelHeight), 0, payloads.back().size()});
+
+        if (!generateMips || (levelWidth == 1 && levelHeight == 1))
+            break;
+
+        int nextWidth = 0, nextHeight = 0;
+        level = downsample(levelWidth, levelHeight, level, nextWidth, nextHeight);
+        levelWidth = nextWidth;
+        levelHeight = nextHeight;
+    }
+
+    CookedTextureHeader header;
+    header.format = static_cast<uint32_t>(format);
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.mipCount = static_cast<uint32_t>(mipHeaders.size());
+
+    // Payloads start 16-byte aligned so uploads can read them in place.
+    size_t offset = sizeof(CookedTextureHeader) + mipHeaders.size() * sizeof(CookedMipHeader);
+    for (size_t i = 0; i < mipHeaders.size(); ++i)
+    {
+        offset = (offset + 15) & ~size_t(15);
+        mipHeaders[i].offset = offset;
+        offset += payloads[i].size();
+    }
+
+    std::vector<unsigned char> bytes(offset, 0);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), mipHeaders.data(), mipHeaders.size() * sizeof(CookedMipHeader));
+    for (size_t i = 0; i < mipHeaders.size(); ++i)
+        std::memcpy(bytes.data() + mipHeaders[i].offset, payloads[i].data(), payloads[i].size());
+
+    return bytes;
+}
+
+bool CookedTexture::isCookedPath(const std::string &filePath)
+{
+    const std::string extension = ".gtex";
+    return filePath.size() >= extension.size() &&
+           filePath.compare(filePath.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+size_t CookedTexture::getMipByteSize(CookedTextureFormat format, int width, int height)
+{
+    switch (format)
+    {
+    case CookedTextureFormat::RGBA8:
+        return static_cast<size_t>(width) * height * 4;
+    case CookedTextureFormat::BC1:
+        return getBlockCompressedSize(width, height, 8);
+    case CookedTextureFormat::BC3:
+        return getBlockCompressedSize(width, height, 16);
+    }
+    throw std::invalid_argument("CookedTexture: unknown format");
+}
+
+CookedTextureFormat CookedTexture::getFormat() const
+{
+    return format;
+}
+
+int CookedTexture::getWidth() const
+{
+    return mips.front().width;
+}
+
+int CookedTexture::getHeight() const
+{
+    return mips.front().height;
+}
+
+size_t CookedTexture::getMipCount() const
+{
+    return mips.size();
+}
+
+const CookedMip &CookedTexture::getMip(size_t level) const
+{
+    if (level >= mips.size())
+        throw std::out_of_range("CookedTexture: mip level out of range");
+
+    return mips[level];
+}
+
+void CookedTexture::prefault() const
+{
+    // Touch every page of the mapping so the GL thread never stalls on a
+    // page fault in the middle of an upload.
+    volatile unsigned char sink = 0;
+    for (const auto &mip : mips)
+        for (size_t i = 0; i < mip.byteSize; i += 4096)
+            sink = sink + mip.data[i];
+}
+
+void CookedTexture::parse(const unsigned char *bytes, size_t byteSize)
+{
+    CookedTextureHeader header;
+    if (byteSize < sizeof(header))
+        throw std::runtime_error("CookedTexture: file is too small");
+
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != CookedTextureHeader::Magic)
+        throw std::runtime_error("CookedTexture: bad magic");
+    if (header.version != CookedTextureHeader::Version)
+        throw std::runtime_error("CookedTexture: unsupported version");
+    if (header.format > static_cast<uint32_t>(CookedTextureFormat::BC3))
+        throw std::runtime_error("CookedTexture: unknown format");
+    if (header.mipCount == 0 || header.mipCount > 32)
+        throw std::runtime_error("CookedTexture: bad mip count");
+    if (byteSize < sizeof(header) + header.mipCount * sizeof(CookedMipHeader))
+        throw std::runtime_error("CookedTexture: truncated mip table");
+
+    format = static_cast<CookedTextureFormat>(header.format);
+    mips.reserve(header.mipCount);
+    for (uint32_t i = 0; i < header.mipCount; ++i)
+    {
+        CookedMipHeader mipHeader;
+        std::memcpy(&mipHeader, bytes + sizeof(header) + i * sizeof(CookedMipHeader), sizeof(mipHeader));
+
+        if (mipHeader.width == 0 || mipHeader.height == 0 ||
+            mipHeader.byteSize != getMipByteSize(format, mipHeader.width, mipHeader.height) ||
+            mipHeader.offset > byteSize || mipHeader.byteSize > byteSize - mipHeader.offset)
+            throw std::runtime_error("CookedTexture: corrupt mip table");
+
+        mips.push_back({static_cast<int>(mipHeader.width), static_cast<int>(mipHeader.height),
+                        bytes + mipHeader.offset, static_cast<size_t>(mipHeader.byteSize)});
+    }
+
+    if (mips.front().width != static_cast<int>(header.width) || mips.front().height != static_cast<int>(header.height))
+        throw std::runtime_error("CookedTexture: mip 0 does not match header");
+}
\ No newline at end of file
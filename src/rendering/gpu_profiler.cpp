@@ -0,0 +1,86 @@
+#include <stdexcept>
+#include "rendering/gpu_profiler.hpp"
+
+GpuProfiler::GpuProfiler(Profiler &profiler, size_t frameLatency, size_t maxQueriesPerFrame)
+    : profiler(profiler), frames(frameLatency)
+{
+    if (frameLatency == 0)
+        throw std::invalid_argument("GpuProfiler: frameLatency must be positive");
+    if (maxQueriesPerFrame < 2)
+        throw std::invalid_argument("GpuProfiler: maxQueriesPerFrame must be at least 2");
+
+    for (auto &frame : frames)
+    {
+        frame.queries.resize(maxQueriesPerFrame);
+        glGenQueries(static_cast<GLsizei>(maxQueriesPerFrame), frame.queries.data());
+    }
+}
+
+GpuProfiler::~GpuProfiler()
+{
+    for (auto &frame : frames)
+        glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+}
+
+void GpuProfiler::beginFrame()
+{
+    currentFrame = (currentFrame + 1) % frames.size();
+    Frame &frame = frames[currentFrame];
+    collect(frame);
+    frame.ranges.clear();
+    frame.usedQueries = 0;
+}
+
+bool GpuProfiler::isEnabled() const
+{
+    return profiler.isEnabled();
+}
+
+size_t GpuProfiler::timestamp()
+{
+    Frame &frame = frames[currentFrame];
+    if (frame.usedQueries == frame.queries.size())
+        return invalidQuery;
+
+    // Timestamps rather than GL_TIME_ELAPSED, because elapsed queries cannot
+    // nest and Game::render wraps every state's render.
+    glQueryCounter(frame.queries[frame.usedQueries], GL_TIMESTAMP);
+    return frame.usedQueries++;
+}
+
+void GpuProfiler::addRange(const char *name, const char *detail, size_t beginQuery, size_t endQuery)
+{
+    if (beginQuery == invalidQuery || endQuery == invalidQuery)
+        return;
+
+    frames[currentFrame].ranges.push_back({name, detail, beginQuery, endQuery});
+}
+
+size_t GpuProfiler::getDroppedFrameCount() const
+{
+    return droppedFrames;
+}
+
+void GpuProfiler::collect(Frame &frame)
+{
+    if (frame.ranges.empty())
+        return;
+
+    // Queries complete in submission order, so the last one being ready
+    // means every earlier result can be read without blocking.
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+    {
+        ++droppedFrames;
+        return;
+    }
+
+    for (const auto &range : frame.ranges)
+    {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(frame.queries[range.beginQuery], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.queries[range.endQuery], GL_QUERY_RESULT, &end);
+        profiler.recordGpu(range.name, range.detail, static_cast<double>(end - begin) * 1e-9);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <stdexcept>
+#include "rendering/image.hpp"
+#include "stb_image.h"
+
+Image::Image(const std::string &filePath, bool flipY)
+{
+    if (filePath.empty())
+        throw std::invalid_argument("Image filePath must not be empty");
+
+    // Images decode on worker threads, so the flip flag must not leak
+    // between them through stb's global setting.
+    stbi_set_flip_vertically_on_load_thread(flipY);
+    pixels.reset(stbi_load(filePath.c_str(), &width, &height, &channels, STBI_rgb_alpha));
+    if (!pixels)
+        throw std::runtime_error("Failed to load Image: " + filePath);
+}
+
+int Image::getWidth() const
+{
+    return width;
+}
+
+int Image::getHeight() const
+{
+    return height;
+}
+
+int Image::getChannels() const
+{
+    return channels;
+}
+
+const unsigned char *Image::getPixels() const
+{
+    return pixels.get();
+}
+
+size_t Image::getByteSize() const
+{
+    return static_cast<size_t>(width) * height * 4;
+}
+
+void Image::PixelDeleter::operator()(unsigned char *pixels) const
+{
+    stbi_image_free(pixels);
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <cstring>
+#include <stdexcept>
+#include "rendering/pixel_upload_ring.hpp"
+
+PixelUploadRing::PixelUploadRing(size_t bufferCount, size_t initialBufferSize)
+    : slots(bufferCount), persistent(GLAD_GL_VERSION_4_4 != 0)
+{
+    if (bufferCount == 0)
+        throw std::invalid_argument("PixelUploadRing: bufferCount must be positive");
+
+    for (auto &slot : slots)
+        allocate(slot, initialBufferSize);
+}
+
+PixelUploadRing::~PixelUploadRing()
+{
+    for (auto &slot : slots)
+        release(slot);
+}
+
+void PixelUploadRing::upload(int width, int height, const unsigned char *rgbaPixels)
+{
+    if (width <= 0 || height <= 0 || !rgbaPixels)
+        throw std::invalid_argument("PixelUploadRing: upload received an empty image");
+
+    size_t byteSize = static_cast<size_t>(width) * height * 4;
+    Slot &slot = slots[nextSlot];
+    nextSlot = (nextSlot + 1) % slots.size();
+
+    // The GPU may still be reading this slot from its last trip round the ring.
+    waitForSlot(slot);
+    if (slot.capacity < byteSize)
+    {
+        release(slot);
+        allocate(slot, byteSize);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    if (persistent)
+    {
+        std::memcpy(slot.mapped, rgbaPixels, byteSize);
+    }
+    else
+    {
+        void *mapped = glMapBufferRange(
+            GL_PIXEL_UNPACK_BUFFER, 0, byteSize,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (!mapped)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            throw std::runtime_error("PixelUploadRing: failed to map pixel buffer");
+        }
+
+        std::memcpy(mapped, rgbaPixels, byteSize);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+
+    // Sources from the bound unpack buffer, so this returns as soon as the
+    // copy is queued and the driver DMAs it while we fill the next slot.
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+bool PixelUploadRing::isPersistent() const
+{
+    return persistent;
+}
+
+void PixelUploadRing::waitForSlot(Slot &slot)
+{
+    if (!slot.fence)
+        return;
+
+    GLenum result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(slot.fence, 0, 1000000000);
+
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+}
+
+void PixelUploadRing::allocate(Slot &slot, size_t capacity)
+{
+    glGenBuffers(1, &slot.buffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    if (persistent)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, capacity, nullptr, flags);
+        slot.mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, capacity, flags);
+        if (!slot.mapped)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            throw std::runtime_error("PixelUploadRing: failed to persistently map pixel buffer");
+        }
+    }
+    else
+    {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    slot.capacity = capacity;
+}
+
+void PixelUploadRing::release(Slot &slot)
+{
+    waitForSlot(slot);
+    if (slot.buffer == 0)
+        return;
+
+    if (slot.mapped)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        slot.mapped = nullptr;
+    }
+
+    glDeleteBuffers(1, &slot.buffer);
+    slot.buffer = 0;
+    slot.capacity = 0;
+}
\ No newline at end of file
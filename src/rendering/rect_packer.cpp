@@ -0,0 +1,131 @@
+#include <climits>
+#include <stdexcept>
+#include "rendering/rect_packer.hpp"
+
+RectPacker::RectPacker(int width, int height)
+    : width(width), height(height)
+{
+    if (width <= 0 || height <= 0)
+        throw std::invalid_argument("RectPacker: dimensions must be positive");
+
+    reset();
+}
+
+bool RectPacker::pack(int rectWidth, int rectHeight, PackedRect &packed)
+{
+    if (rectWidth <= 0 || rectHeight <= 0)
+        throw std::invalid_argument("RectPacker: rect dimensions must be positive");
+
+    size_t node = 0;
+    int x = 0, y = 0;
+    if (!findPosition(rectWidth, rectHeight, node, x, y))
+        return false;
+
+    packed = {x, y, rectWidth, rectHeight};
+    usedArea += static_cast<long long>(rectWidth) * rectHeight;
+
+    // Raise the skyline over the new rect, then trim the nodes it now shadows.
+    skyline.insert(skyline.begin() + node, {x, y + rectHeight, rectWidth});
+    for (size_t i = node + 1; i < skyline.size();)
+    {
+        const SkylineNode &previous = skyline[i - 1];
+        SkylineNode &current = skyline[i];
+        int previousEnd = previous.x + previous.width;
+        if (current.x >= previousEnd)
+            break;
+
+        int shrink = previousEnd - current.x;
+        if (current.width <= shrink)
+        {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+
+        current.x += shrink;
+        current.width -= shrink;
+        break;
+    }
+
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+void RectPacker::reset()
+{
+    usedArea = 0;
+    skyline.clear();
+    skyline.push_back({0, 0, width});
+}
+
+int RectPacker::getWidth() const
+{
+    return width;
+}
+
+int RectPacker::getHeight() const
+{
+    return height;
+}
+
+float RectPacker::getOccupancy() const
+{
+    return static_cast<float>(static_cast<double>(usedArea) / (static_cast<double>(width) * height));
+}
+
+bool RectPacker::findPosition(int rectWidth, int rectHeight, size_t &bestNode, int &bestX, int &bestY) const
+{
+    int bestTop = INT_MAX, bestNodeWidth = INT_MAX;
+    bool found = false;
+    for (size_t i = 0; i < skyline.size(); ++i)
+    {
+        int y = 0;
+        if (!fits(i, rectWidth, rectHeight, y))
+            continue;
+
+        int top = y + rectHeight;
+        if (top < bestTop || (top == bestTop && skyline[i].width < bestNodeWidth))
+        {
+            bestTop = top;
+            bestNodeWidth = skyline[i].width;
+            bestNode = i;
+            bestX = skyline[i].x;
+            bestY = y;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool RectPacker::fits(size_t node, int rectWidth, int rectHeight, int &y) const
+{
+    if (skyline[node].x + rectWidth > width)
+        return false;
+
+    y = skyline[node].y;
+    int remaining = rectWidth;
+    for (size_t i = node; remaining > 0; ++i)
+    {
+        if (i >= skyline.size())
+            return false;
+
+        if (skyline[i].y > y)
+            y = skyline[i].y;
+        if (y + rectHeight > height)
+            return false;
+
+        remaining -= skyline[i].width;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <GLFW/glfw3.h>
+#include <stdexcept>
+#include "rendering/render_thread.hpp"
+
+RenderThread::RenderThread(GLFWwindow *window, RenderFunction renderFrame)
+    : window(window),
+      renderFrame(std::move(renderFrame))
+{
+    if (!window)
+        throw std::invalid_argument("RenderThread: window must not be null");
+    if (!this->renderFrame)
+        throw std::invalid_argument("RenderThread: renderFrame must not be empty");
+
+    // A context can only be current on one thread at a time.
+    glfwMakeContextCurrent(nullptr);
+    thread = std::thread([this]
+                         { run(); });
+}
+
+RenderThread::~RenderThread()
+{
+    stopping.store(true, std::memory_order_release);
+    publishedFrames.fetch_add(1, std::memory_order_release);
+    publishedFrames.notify_one();
+    thread.join();
+
+    glfwMakeContextCurrent(window);
+}
+
+FrameSnapshot &RenderThread::getWriteSnapshot()
+{
+    return snapshots.getWriteBuffer();
+}
+
+void RenderThread::publish()
+{
+    snapshots.publish();
+    uint64_t published = publishedFrames.fetch_add(1, std::memory_order_release) + 1;
+    publishedFrames.notify_one();
+
+    // Running further ahead than one frame only adds latency: the render
+    // thread skips to the newest snapshot anyway.
+    uint64_t rendered = renderedFrames.load(std::memory_order_acquire);
+    while (published - rendered > 1 && !failed.load(std::memory_order_acquire))
+    {
+        renderedFrames.wait(rendered, std::memory_order_acquire);
+        rendered = renderedFrames.load(std::memory_order_acquire);
+    }
+
+    if (failed.load(std::memory_order_acquire))
+        std::rethrow_exception(error);
+}
+
+uint64_t RenderThread::getRenderedFrameCount() const
+{
+    return renderedFrames.load(std::memory_order_acquire);
+}
+
+void RenderThread::run()
+{
+    glfwMakeContextCurrent(window);
+
+    uint64_t seen = 0;
+    try
+    {
+        while (true)
+        {
+            publishedFrames.wait(seen, std::memory_order_acquire);
+            if (stopping.load(std::memory_order_acquire))
+                break;
+
+            seen = publishedFrames.load(std::memory_order_acquire);
+            if (snapshots.acquire())
+                renderFrame(snapshots.getReadBuffer());
+
+            renderedFrames.store(seen, std::memory_order_release);
+            renderedFrames.notify_one();
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+        failed.store(true, std::memory_order_release);
+        renderedFrames.fetch_add(1, std::memory_order_release);
+        renderedFrames.notify_one();
+    }
+
+    glfwMakeContextCurrent(nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <stdexcept>
+#include "rendering/sprite_batch.hpp"
+
+void SpriteBatch::begin(glm::vec2 viewSize, glm::ivec2 framebufferSize)
+{
+    this->viewSize = viewSize;
+    this->framebufferSize = framebufferSize;
+    submitted.clear();
+    sortEntries.clear();
+    instances.clear();
+    drawRanges.clear();
+}
+
+void SpriteBatch::draw(
+    GLuint texture,
+    glm::vec2 position,
+    glm::vec2 size,
+    glm::vec4 uvRect,
+    uint32_t color,
+    float rotation,
+    int layer)
+{
+    if (texture == 0)
+        throw std::invalid_argument("SpriteBatch: draw received texture 0");
+
+    // Layer in the high half, biased so negative layers sort first.
+    uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(layer) ^ 0x80000000u) << 32 | texture;
+    sortEntries.push_back({key, static_cast<uint32_t>(submitted.size())});
+    submitted.push_back({glm::vec4(position.x, position.y, size.x, size.y), uvRect, color, rotation});
+}
+
+void SpriteBatch::end()
+{
+    // The index breaks ties, which keeps the order stable without the extra
+    // buffer std::stable_sort allocates.
+    std::sort(sortEntries.begin(), sortEntries.end(), [](const SortEntry &a, const SortEntry &b)
+              { return a.key != b.key ? a.key < b.key : a.index < b.index; });
+
+    instances.clear();
+    instances.reserve(submitted.size());
+    drawRanges.clear();
+    for (const SortEntry &entry : sortEntries)
+    {
+        GLuint texture = static_cast<GLuint>(entry.key);
+        if (drawRanges.empty() || drawRanges.back().texture != texture)
+            drawRanges.push_back({texture, instances.size(), 0});
+
+        instances.push_back(submitted[entry.index]);
+        ++drawRanges.back().count;
+    }
+
+    sortEntries.clear();
+    submitted.clear();
+}
+
+const std::vector<SpriteInstance> &SpriteBatch::getInstances() const
+{
+    return instances;
+}
+
+const std::vector<SpriteDrawRange> &SpriteBatch::getDrawRanges() const
+{
+    return drawRanges;
+}
+
+glm::vec2 SpriteBatch::getViewSize() const
+{
+    return viewSize;
+}
+
+glm::ivec2 SpriteBatch::getFramebufferSize() const
+{
+    return framebufferSize;
+}
+
+size_t SpriteBatch::size() const
+{
+    return instances.size() + submitted.size();
+}
+
+bool SpriteBatch::isEmpty() const
+{
+    return size() == 0;
+}
\ No newline at end of file
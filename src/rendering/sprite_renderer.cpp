@@ -0,0 +1,284 @@
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <glm/gtc/type_ptr.hpp>
+#include "rendering/sprite_renderer.hpp"
+
+namespace
+{
+    // Corners come from gl_VertexID, so the quad needs no vertex buffer of
+    // its own; everything else is per instance.
+    const char *vertexShaderSource = R"(#version 330 core
+layout(location = 0) in vec4 rect;
+layout(location = 1) in vec4 uvRect;
+layout(location = 2) in vec4 color;
+layout(location = 3) in float rotation;
+uniform mat4 projection;
+out vec2 uv;
+out vec4 tint;
+void main()
+{
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    vec2 local = (corner - 0.5) * rect.zw;
+    float s = sin(rotation), c = cos(rotation);
+    vec2 position = rect.xy + 0.5 * rect.zw + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+    gl_Position = projection * vec4(position, 0.0, 1.0);
+    uv = mix(uvRect.xy, uvRect.zw, corner);
+    tint = color;
+}
+)";
+
+    const char *fragmentShaderSource = R"(#version 330 core
+in vec2 uv;
+in vec4 tint;
+uniform sampler2D spriteTexture;
+out vec4 fragColor;
+void main()
+{
+    fragColor = texture(spriteTexture, uv) * tint;
+}
+)";
+
+    GLuint compileShader(GLenum type, const char *source)
+    {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+
+        GLint compiled = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+        if (!compiled)
+        {
+            char log[1024] = {};
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            glDeleteShader(shader);
+            throw std::runtime_error(std::string("SpriteRenderer: failed to compile shader: ") + log);
+        }
+        return shader;
+    }
+}
+
+SpriteRenderer::SpriteRenderer(size_t initialCapacity, size_t regionCount)
+    : regions(regionCount), persistent(GLAD_GL_VERSION_4_4 != 0)
+{
+    if (initialCapacity == 0)
+        throw std::invalid_argument("SpriteRenderer: initialCapacity must be positive");
+    if (regionCount == 0)
+        throw std::invalid_argument("SpriteRenderer: regionCount must be positive");
+
+    createProgram();
+
+    glGenVertexArrays(1, &vertexArray);
+    glBindVertexArray(vertexArray);
+    for (GLuint attribute = 0; attribute < 4; ++attribute)
+    {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    glBindVertexArray(0);
+
+    allocate(initialCapacity);
+}
+
+SpriteRenderer::~SpriteRenderer()
+{
+    release();
+    glDeleteVertexArrays(1, &vertexArray);
+    glDeleteProgram(program);
+}
+
+void SpriteRenderer::render(const SpriteBatch &batch)
+{
+    drawCallCount = 0;
+    const auto &drawRanges = batch.getDrawRanges();
+    if (drawRanges.empty())
+        return;
+
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    size_t firstInstance = upload(batch.getInstances());
+
+    // ImGui restores the viewport it found, which goes stale on resize.
+    glm::ivec2 framebufferSize = batch.getFramebufferSize();
+    glViewport(0, 0, framebufferSize.x, framebufferSize.y);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_SCISSOR_TEST);
+
+    glm::vec2 viewSize = batch.getViewSize();
+    glm::mat4 projection = glm::ortho(0.0f, viewSize.x, viewSize.y, 0.0f);
+    glUseProgram(program);
+    glUniformMatrix4fv(projectionLocation, 1, GL_FALSE, glm::value_ptr(projection));
+    glUniform1i(textureLocation, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    // GL 3.3 has no base instance, so each range re-points the instance
+    // attributes at its slice of the buffer instead.
+    for (const SpriteDrawRange &range : drawRanges)
+    {
+        glBindTexture(GL_TEXTURE_2D, range.texture);
+        setInstanceOffset(firstInstance + range.first);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(range.count));
+        ++drawCallCount;
+    }
+
+    if (persistent)
+    {
+        regions[nextRegion].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        nextRegion = (nextRegion + 1) % regions.size();
+    }
+
+    glUseProgram(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+size_t SpriteRenderer::getDrawCallCount() const
+{
+    return drawCallCount;
+}
+
+bool SpriteRenderer::isPersistent() const
+{
+    return persistent;
+}
+
+void SpriteRenderer::createProgram()
+{
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    GLuint fragmentShader = 0;
+    try
+    {
+        fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+    }
+    catch (...)
+    {
+        glDeleteShader(vertexShader);
+        throw;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        char log[1024] = {};
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        glDeleteProgram(program);
+        program = 0;
+        throw std::runtime_error(std::string("SpriteRenderer: failed to link program: ") + log);
+    }
+
+    projectionLocation = glGetUniformLocation(program, "projection");
+    textureLocation = glGetUniformLocation(program, "spriteTexture");
+}
+
+void SpriteRenderer::allocate(size_t capacity)
+{
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (persistent)
+    {
+        size_t byteSize = capacity * regions.size() * sizeof(SpriteInstance);
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, byteSize, nullptr, flags);
+        mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, byteSize, flags);
+        if (!mapped)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            throw std::runtime_error("SpriteRenderer: failed to persistently map instance buffer");
+        }
+    }
+    else
+    {
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(SpriteInstance), nullptr, GL_STREAM_DRAW);
+    }
+    this->capacity = capacity;
+}
+
+void SpriteRenderer::release()
+{
+    for (auto &region : regions)
+        waitForRegion(region);
+
+    if (buffer == 0)
+        return;
+
+    if (mapped)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        mapped = nullptr;
+    }
+
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+    capacity = 0;
+}
+
+void SpriteRenderer::waitForRegion(Region &region)
+{
+    if (!region.fence)
+        return;
+
+    GLenum result = glClientWaitSync(region.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(region.fence, 0, 1000000000);
+
+    glDeleteSync(region.fence);
+    region.fence = nullptr;
+}
+
+size_t SpriteRenderer::upload(const std::vector<SpriteInstance> &instances)
+{
+    if (instances.size() > capacity)
+    {
+        size_t newCapacity = capacity;
+        while (newCapacity < instances.size())
+            newCapacity *= 2;
+
+        release();
+        allocate(newCapacity);
+    }
+
+    size_t byteSize = instances.size() * sizeof(SpriteInstance);
+    if (persistent)
+    {
+        // The GPU may still be drawing from this region's last trip round
+        // the ring.
+        waitForRegion(regions[nextRegion]);
+        size_t firstInstance = nextRegion * capacity;
+        std::memcpy(static_cast<SpriteInstance *>(mapped) + firstInstance, instances.data(), byteSize);
+        return firstInstance;
+    }
+
+    // Orphaning hands the driver a fresh block while the GPU finishes with
+    // the old one, so the write never waits.
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(SpriteInstance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, byteSize, instances.data());
+    return 0;
+}
+
+void SpriteRenderer::setInstanceOffset(size_t firstInstance)
+{
+    const GLsizei stride = sizeof(SpriteInstance);
+    const size_t base = firstInstance * sizeof(SpriteInstance);
+    auto offset = [base](size_t member)
+    {
+        return reinterpret_cast<const void *>(base + member);
+    };
+
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, offset(offsetof(SpriteInstance, rect)));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, offset(offsetof(SpriteInstance, uvRect)));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, offset(offsetof(SpriteInstance, color)));
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, offset(offsetof(SpriteInstance, rotation)));
+}
\ No newline at end of file
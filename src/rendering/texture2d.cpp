@@ -1,37 +1,75 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include <stdexcept>
+#include <vector>
+#include "rendering/block_compression.hpp"
+#include "rendering/cooked_texture.hpp"
+#include "rendering/image.hpp"
+#include "rendering/pixel_upload_ring.hpp"
 #include "rendering/texture2d.hpp"
-#include "stb_image.h"
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace
+{
+    bool supportsS3TC()
+    {
+        static const bool supported = []()
+        {
+            GLint extensionCount = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+            for (GLint i = 0; i < extensionCount; ++i)
+            {
+                const char *name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+                if (name && std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+                    return true;
+            }
+            return false;
+        }();
+        return supported;
+    }
+}
 
 Texture2D::Texture2D(const std::string &filePath, bool flipY)
-    : textureID(0), width(0), height(0), channels(0)
+    : Texture2D(Image(filePath, flipY))
+{
+}
+
+Texture2D::Texture2D(const Image &image, const TextureSettings &settings, PixelUploadRing *uploadRing)
+    : textureID(0), width(image.getWidth()), height(image.getHeight()), channels(image.getChannels())
 {
-    if (filePath.empty())
-        throw std::invalid_argument("Texture2D filePath must not be empty");
+    upload(image.getPixels(), settings, uploadRing);
+}
 
-    stbi_set_flip_vertically_on_load(flipY);
-    unsigned char *data = stbi_load(filePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-    if (!data)
-        throw std::runtime_error("Failed to load Texture2D");
+Texture2D::Texture2D(
+    int width, int height, const unsigned char *rgbaPixels,
+    const TextureSettings &settings,
+    PixelUploadRing *uploadRing)
+    : textureID(0), width(width), height(height), channels(4)
+{
+    if (width <= 0 || height <= 0)
+        throw std::invalid_argument("Texture2D dimensions must be positive");
+    if (!rgbaPixels)
+        throw std::invalid_argument("Texture2D rgbaPixels must not be nullptr");
 
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    upload(rgbaPixels, settings, uploadRing);
+}
 
-    stbi_image_free(data);
+Texture2D::Texture2D(const CookedTexture &cookedTexture, const TextureSettings &settings)
+    : textureID(0), width(cookedTexture.getWidth()), height(cookedTexture.getHeight()), channels(4)
+{
+    uploadCooked(cookedTexture, settings);
 }
 
 Texture2D::~Texture2D()
 {
-    if (textureID != 0)
-    {
-        glDeleteTextures(1, &textureID);
-        textureID = 0;
-    }
+    deleteTexture();
 }
 
 void Texture2D::bind() const
@@ -49,6 +87,16 @@ unsigned int Texture2D::getHeight() const
     return height;
 }
 
+int Texture2D::getMipLevels() const
+{
+    return mipLevels;
+}
+
+size_t Texture2D::getByteSize() const
+{
+    return byteSize;
+}
+
 GLuint Texture2D::getTextureID() const
 {
     return textureID;
@@ -56,15 +104,146 @@ GLuint Texture2D::getTextureID() const
 
 std::pair<glm::vec2, glm::vec2> Texture2D::getUVRange(int frameIndex, int tileSize, bool flipY) const
 {
+    return getTileUVRange(width, height, frameIndex, tileSize, flipY);
+}
+
+std::pair<glm::vec2, glm::vec2> Texture2D::getTileUVRange(int width, int height, int frameIndex, int tileSize, bool flipY)
+{
+    if (tileSize <= 0 || tileSize > width || tileSize > height)
+        throw std::invalid_argument("Texture2D tileSize must be positive and fit the texture");
+
     int tilesPerRow = width / tileSize;
+    if (frameIndex < 0 || frameIndex >= tilesPerRow * (height / tileSize))
+        throw std::out_of_range("Texture2D frameIndex is outside the tile grid");
+
     int tileX = frameIndex % tilesPerRow;
     int tileY = frameIndex / tilesPerRow;
-    float uvSize = static_cast<float>(tileSize) / static_cast<float>(width);
+    float uvWidth = static_cast<float>(tileSize) / static_cast<float>(width);
+    float uvHeight = static_cast<float>(tileSize) / static_cast<float>(height);
 
     if (flipY)
-        return {glm::vec2(tileX * uvSize, tileY * uvSize),
-                glm::vec2((tileX + 1) * uvSize, (tileY + 1) * uvSize)};
+        return {glm::vec2(tileX * uvWidth, tileY * uvHeight),
+                glm::vec2((tileX + 1) * uvWidth, (tileY + 1) * uvHeight)};
     else
-        return {glm::vec2(tileX * uvSize, (tileY + 1) * uvSize),
-                glm::vec2((tileX + 1) * uvSize, tileY * uvSize)};
+        return {glm::vec2(tileX * uvWidth, (tileY + 1) * uvHeight),
+                glm::vec2((tileX + 1) * uvWidth, tileY * uvHeight)};
+}
+
+void Texture2D::upload(const unsigned char *rgbaPixels, const TextureSettings &settings, PixelUploadRing *uploadRing)
+{
+    // Mips are only built when the min filter will actually sample them.
+    mipLevels = settings.usesMipmaps()
+                    ? std::bit_width(static_cast<unsigned int>(std::max(width, height)))
+                    : 1;
+    byteSize = 0;
+    for (int level = 0; level < mipLevels; ++level)
+        byteSize += static_cast<size_t>(std::max(width >> level, 1)) * std::max(height >> level, 1) * 4;
+
+    createTexture(settings);
+
+    // The constructor throwing means no destructor, so the name is
+    // released here.
+    try
+    {
+        bool allocated = false;
+        if (settings.immutableStorage && GLAD_GL_VERSION_4_2)
+        {
+            glTexStorage2D(GL_TEXTURE_2D, mipLevels, GL_RGBA8, width, height);
+            allocated = true;
+        }
+
+        if (uploadRing)
+        {
+            if (!allocated)
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            uploadRing->upload(width, height, rgbaPixels);
+        }
+        else if (allocated)
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
+        }
+        else
+        {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
+        }
+
+        if (mipLevels > 1)
+            glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    catch (...)
+    {
+        deleteTexture();
+        throw;
+    }
+}
+
+void Texture2D::uploadCooked(const CookedTexture &cookedTexture, const TextureSettings &settings)
+{
+    // The cooker already built the mip chain, so there is nothing to
+    // generate here; levels the filter never samples are not uploaded.
+    mipLevels = settings.usesMipmaps() ? static_cast<int>(cookedTexture.getMipCount()) : 1;
+    createTexture(settings);
+
+    CookedTextureFormat format = cookedTexture.getFormat();
+    bool compressed = format != CookedTextureFormat::RGBA8,
+         native = compressed && supportsS3TC();
+    GLenum compressedFormat = format == CookedTextureFormat::BC1
+                                  ? GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+                                  : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+    try
+    {
+        byteSize = 0;
+        for (int level = 0; level < mipLevels; ++level)
+        {
+            const CookedMip &mip = cookedTexture.getMip(level);
+            if (native)
+            {
+                glCompressedTexImage2D(
+                    GL_TEXTURE_2D, level, compressedFormat, mip.width, mip.height, 0,
+                    static_cast<GLsizei>(mip.byteSize), mip.data);
+                byteSize += mip.byteSize;
+            }
+            else if (compressed)
+            {
+                // Drivers without S3TC still get the pixels, just decoded here.
+                std::vector<unsigned char> rgbaPixels = format == CookedTextureFormat::BC1
+                                                            ? decompressBC1(mip.width, mip.height, mip.data)
+                                                            : decompressBC3(mip.width, mip.height, mip.data);
+                glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels.data());
+                byteSize += rgbaPixels.size();
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, mip.data);
+                byteSize += mip.byteSize;
+            }
+        }
+    }
+    catch (...)
+    {
+        deleteTexture();
+        throw;
+    }
+}
+
+void Texture2D::createTexture(const TextureSettings &settings)
+{
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, settings.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, settings.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, settings.minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, settings.magFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipLevels - 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void Texture2D::deleteTexture()
+{
+    if (textureID != 0)
+    {
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <stdexcept>
+#include "rendering/image.hpp"
+#include "rendering/texture_atlas.hpp"
+
+TextureAtlas::TextureAtlas(const std::vector<AtlasSource> &sources, int pageSize, int padding)
+    : layout(sources, pageSize, padding)
+{
+    pageTextures.reserve(layout.getPageCount());
+    for (size_t page = 0; page < layout.getPageCount(); ++page)
+        pageTextures.push_back(std::make_unique<Texture2D>(pageSize, pageSize, layout.getPagePixels(page).data()));
+
+    // The GL textures hold the pixels from here on.
+    layout.releasePixels();
+}
+
+AtlasSource TextureAtlas::makeSource(const std::string &name, const Image &image)
+{
+    return {name, image.getWidth(), image.getHeight(), image.getPixels()};
+}
+
+uint32_t TextureAtlas::getFrameIndex(const std::string &name) const
+{
+    return layout.getFrameIndex(name);
+}
+
+size_t TextureAtlas::getFrameCount() const
+{
+    return layout.getFrameCount();
+}
+
+const UVRect &TextureAtlas::getUV(uint32_t frame) const
+{
+    return layout.getUV(frame);
+}
+
+uint16_t TextureAtlas::getPage(uint32_t frame) const
+{
+    return layout.getPage(frame);
+}
+
+void TextureAtlas::getUVs(std::span<const uint32_t> frames, std::span<UVRect> uvs) const
+{
+    layout.getUVs(frames, uvs);
+}
+
+size_t TextureAtlas::getPageCount() const
+{
+    return pageTextures.size();
+}
+
+const Texture2D &TextureAtlas::getPageTexture(size_t page) const
+{
+    if (page >= pageTextures.size())
+        throw std::out_of_range("TextureAtlas: page index out of range");
+
+    return *pageTextures[page];
+}
+
+const AtlasLayout &TextureAtlas::getLayout() const
+{
+    return layout;
+}
\ No newline at end of file
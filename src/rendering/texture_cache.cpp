@@ -0,0 +1,142 @@
+#include <filesystem>
+#include "rendering/texture_cache.hpp"
+
+TextureCache::TextureCache(TextureLoader &textureLoader, size_t budgetBytes)
+    : textureLoader(textureLoader), budgetBytes(budgetBytes)
+{
+}
+
+std::shared_ptr<TextureHandle> TextureCache::load(const std::string &filePath, bool flipY)
+{
+    if (filePath.empty())
+        throw std::invalid_argument("TextureCache: load received empty filePath");
+
+    std::string key = makeKey(filePath, flipY);
+    {
+        std::lock_guard lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end())
+        {
+            // A failed load is retried rather than handed out again.
+            if (!it->second.handle->hasFailed())
+            {
+                ++stats.hits;
+                lru.splice(lru.begin(), lru, it->second.lruPosition);
+                return it->second.handle;
+            }
+            eraseLocked(it);
+        }
+        ++stats.misses;
+    }
+
+    // Queued outside the lock so a trim on the render thread never waits
+    // behind it. If another thread queued the same file meanwhile, its
+    // handle wins and this one is abandoned before upload.
+    auto handle = textureLoader.load(filePath, flipY);
+
+    std::lock_guard lock(mutex);
+    auto it = entries.find(key);
+    if (it != entries.end())
+        return it->second.handle;
+
+    lru.push_front(key);
+    entries.emplace(std::move(key), Entry{handle, lru.begin()});
+    return handle;
+}
+
+void TextureCache::trim()
+{
+    std::lock_guard lock(mutex);
+
+    // Failed entries hold no texture; drop them so nothing keeps finding
+    // them, budget or not.
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        auto next = std::next(it);
+        if (it->second.handle->hasFailed() && it->second.handle.use_count() == 1)
+            eraseLocked(it);
+        it = next;
+    }
+
+    size_t residentBytes = getResidentBytesLocked();
+    if (residentBytes <= budgetBytes)
+        return;
+
+    // Walk from least to most recently used, dropping only entries that no
+    // state still holds. Anything referenced stays resident regardless of
+    // the budget.
+    for (auto it = lru.end(); it != lru.begin() && residentBytes > budgetBytes;)
+    {
+        --it;
+        auto entry = entries.find(*it);
+        if (entry->second.handle.use_count() > 1)
+            continue;
+
+        residentBytes -= getTextureBytes(*entry->second.handle);
+        entries.erase(entry);
+        it = lru.erase(it);
+        ++stats.evictions;
+    }
+}
+
+void TextureCache::setBudget(size_t budgetBytes)
+{
+    std::lock_guard lock(mutex);
+    this->budgetBytes = budgetBytes;
+}
+
+size_t TextureCache::getBudget() const
+{
+    std::lock_guard lock(mutex);
+    return budgetBytes;
+}
+
+size_t TextureCache::getResidentBytes() const
+{
+    std::lock_guard lock(mutex);
+    return getResidentBytesLocked();
+}
+
+size_t TextureCache::getResidentBytesLocked() const
+{
+    size_t residentBytes = 0;
+    for (const auto &[key, entry] : entries)
+        residentBytes += getTextureBytes(*entry.handle);
+
+    return residentBytes;
+}
+
+size_t TextureCache::size() const
+{
+    std::lock_guard lock(mutex);
+    return entries.size();
+}
+
+TextureCache::Stats TextureCache::getStats() const
+{
+    std::lock_guard lock(mutex);
+    return stats;
+}
+
+void TextureCache::eraseLocked(std::unordered_map<std::string, Entry>::iterator entry)
+{
+    lru.erase(entry->second.lruPosition);
+    entries.erase(entry);
+}
+
+std::string TextureCache::makeKey(const std::string &filePath, bool flipY)
+{
+    // Purely lexical, so a hit costs no syscall; a relative and an absolute
+    // spelling of one file are cached separately.
+    std::string key = std::filesystem::path(filePath).lexically_normal().generic_string();
+    key += flipY ? "|flipY" : "|";
+    return key;
+}
+
+size_t TextureCache::getTextureBytes(const TextureHandle &handle)
+{
+    if (!handle.isReady())
+        return 0;
+
+    return handle.getTexture().getByteSize();
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include "rendering/texture_loader.hpp"
+
+TextureHandle::TextureHandle(std::string filePath, bool flipY, std::shared_ptr<const Texture2D> placeholder)
+    : filePath(std::move(filePath)), flipY(flipY), placeholder(std::move(placeholder))
+{
+}
+
+bool TextureHandle::isReady() const
+{
+    return ready.load(std::memory_order_acquire);
+}
+
+bool TextureHandle::hasFailed() const
+{
+    return failed.load(std::memory_order_acquire);
+}
+
+const std::string &TextureHandle::getFilePath() const
+{
+    return filePath;
+}
+
+bool TextureHandle::getFlipY() const
+{
+    return flipY;
+}
+
+size_t TextureHandle::getFileSize() const
+{
+    return fileSize.load(std::memory_order_acquire);
+}
+
+const Texture2D &TextureHandle::getTexture() const
+{
+    return isReady() ? *texture : *placeholder;
+}
+
+GLuint TextureHandle::getTextureID() const
+{
+    return getTexture().getTextureID();
+}
+
+TextureLoader::TextureLoader(size_t workerCount)
+    : workers(workerCount)
+{
+    const unsigned char transparentPixel[4] = {0, 0, 0, 0};
+    placeholder = std::make_shared<const Texture2D>(1, 1, transparentPixel);
+}
+
+std::shared_ptr<TextureHandle> TextureLoader::load(const std::string &filePath, bool flipY)
+{
+    if (filePath.empty())
+        throw std::invalid_argument("TextureLoader: load received empty filePath");
+
+    auto handle = std::make_shared<TextureHandle>(filePath, flipY, placeholder);
+
+    ++pendingCount;
+    workers.submit([this, handle]()
+                   {
+        // Stat here rather than in load, which runs on the main thread.
+        std::error_code sizeError;
+        auto fileSize = std::filesystem::file_size(handle->getFilePath(), sizeError);
+        if (!sizeError)
+            handle->fileSize.store(static_cast<size_t>(fileSize), std::memory_order_release);
+
+        DecodedImage result{handle};
+        try
+        {
+            // Cooked textures skip decoding entirely: the worker only maps
+            // the file and faults its pages in. Their flip is baked in.
+            if (CookedTexture::isCookedPath(handle->getFilePath()))
+            {
+                result.cookedTexture = std::make_unique<CookedTexture>(handle->getFilePath());
+                result.cookedTexture->prefault();
+            }
+            else
+            {
+                result.image = std::make_unique<Image>(handle->getFilePath(), handle->getFlipY());
+            }
+        }
+        catch (...)
+        {
+            result.error = std::current_exception();
+        }
+
+        std::lock_guard lock(decodedMutex);
+        decoded.push_back(std::move(result)); });
+    return handle;
+}
+
+void TextureLoader::processUploads(double budgetSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::duration<double>(budgetSeconds);
+
+    // At least one upload happens per call so a tight budget still makes progress.
+    do
+    {
+        DecodedImage next;
+        {
+            std::lock_guard lock(decodedMutex);
+            if (decoded.empty())
+                return;
+
+            next = std::move(decoded.front());
+            decoded.pop_front();
+        }
+        --pendingCount;
+
+        // Nobody is waiting on this texture any more, so skip the GL work.
+        if (next.handle.use_count() == 1)
+            continue;
+
+        if (!next.error)
+        {
+            try
+            {
+                if (next.cookedTexture)
+                    next.handle->texture = std::make_unique<Texture2D>(*next.cookedTexture);
+                else
+                    next.handle->texture = std::make_unique<Texture2D>(*next.image, TextureSettings{}, &uploadRing);
+            }
+            catch (...)
+            {
+                next.error = std::current_exception();
+            }
+        }
+
+        // One bad asset must not end the game: the handle keeps showing the
+        // placeholder and reports the failure to whoever polls it.
+        if (next.error)
+        {
+            reportFailure(*next.handle, next.error);
+            next.handle->failed.store(true, std::memory_order_release);
+            continue;
+        }
+
+        next.handle->ready.store(true, std::memory_order_release);
+    } while (Clock::now() < deadline);
+}
+
+void TextureLoader::reportFailure(const TextureHandle &handle, const std::exception_ptr &error)
+{
+    try
+    {
+        std::rethrow_exception(error);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "TextureLoader: failed to load " << handle.getFilePath() << ": " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "TextureLoader: failed to load " << handle.getFilePath() << std::endl;
+    }
+}
+
+size_t TextureLoader::getPendingCount() const
+{
+    return pendingCount.load();
+}
+
+const Texture2D &TextureLoader::getPlaceholder() const
+{
+    return *placeholder;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include <cstring>
+#include "rendering/ui/imgui_draw_snapshot.hpp"
+
+namespace
+{
+    // ImVector's assignment frees and reallocates; resizing keeps capacity.
+    template <typename T>
+    void copyBuffer(ImVector<T> &destination, const ImVector<T> &source)
+    {
+        destination.resize(source.Size);
+        if (source.Size > 0)
+            std::memcpy(destination.Data, source.Data, source.size_in_bytes());
+    }
+}
+
+void ImGuiDrawSnapshot::capture(const ImDrawData &source)
+{
+    drawData.Clear();
+
+    while (drawLists.size() < static_cast<size_t>(source.CmdListsCount))
+        drawLists.push_back(std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData()));
+
+    for (int i = 0; i < source.CmdListsCount; ++i)
+    {
+        const ImDrawList &sourceList = *source.CmdLists[i];
+        ImDrawList &list = *drawLists[i];
+        copyBuffer(list.CmdBuffer, sourceList.CmdBuffer);
+        copyBuffer(list.IdxBuffer, sourceList.IdxBuffer);
+        copyBuffer(list.VtxBuffer, sourceList.VtxBuffer);
+        list.Flags = sourceList.Flags;
+        drawData.CmdLists.push_back(&list);
+    }
+
+    drawData.Valid = source.Valid;
+    drawData.CmdListsCount = source.CmdListsCount;
+    drawData.TotalIdxCount = source.TotalIdxCount;
+    drawData.TotalVtxCount = source.TotalVtxCount;
+    drawData.DisplayPos = source.DisplayPos;
+    drawData.DisplaySize = source.DisplaySize;
+    drawData.FramebufferScale = source.FramebufferScale;
+    drawData.OwnerViewport = source.OwnerViewport;
+}
+
+ImDrawData &ImGuiDrawSnapshot::getDrawData()
+{
+    return drawData;
+}
\ No newline at end of file
@@ -15,29 +15,80 @@ ImGuiManager::ImGuiManager(
 
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
-    ImGui_ImplGlfw_InitForOpenGL(window, true);
-    ImGui_ImplOpenGL3_Init(glslVersion);
     ImGui::StyleColorsDark();
+
+    if (window)
+    {
+        ImGui_ImplGlfw_InitForOpenGL(window, true);
+        ImGui_ImplOpenGL3_Init(glslVersion);
+    }
+    else
+    {
+        // The OpenGL backend normally builds the font atlas; without it
+        // NewFrame refuses to run.
+        ImGuiIO &io = getIO();
+        io.IniFilename = nullptr;
+        io.Fonts->Build();
+    }
 }
 
 ImGuiManager::~ImGuiManager()
 {
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
+    if (window)
+    {
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui_ImplGlfw_Shutdown();
+    }
     ImGui::DestroyContext();
 }
 
 void ImGuiManager::newFrame()
 {
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
+    if (window)
+    {
+        if (!rendererDetached)
+            ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+    }
+    else
+    {
+        ImGuiIO &io = getIO();
+        io.DisplaySize = ImVec2(static_cast<float>(windowWidth), static_cast<float>(windowHeight));
+        io.DeltaTime = 1.0f / 60.0f;
+    }
     ImGui::NewFrame();
+    refreshLayout();
 }
 
 void ImGuiManager::renderFrame()
 {
     ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    if (window)
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
+
+void ImGuiManager::setRendererDetached(bool detached)
+{
+    // The renderer creates its shaders and font texture lazily on its first
+    // NewFrame; do it now, while this thread still owns the context, so the
+    // render thread never touches the font atlas. NewFrame only creates
+    // them if they do not exist yet, so toggling pipelining never leaks.
+    if (detached && window)
+        ImGui_ImplOpenGL3_NewFrame();
+
+    rendererDetached = detached;
+}
+
+void ImGuiManager::captureFrame(ImGuiDrawSnapshot &snapshot)
+{
+    ImGui::Render();
+    snapshot.capture(*ImGui::GetDrawData());
+}
+
+void ImGuiManager::renderSnapshot(ImGuiDrawSnapshot &snapshot)
+{
+    if (window)
+        ImGui_ImplOpenGL3_RenderDrawData(&snapshot.getDrawData());
 }
 
 ImGuiIO &ImGuiManager::getIO() const
@@ -58,6 +109,29 @@ glm::vec2 ImGuiManager::screenToWorld(ImVec2 screenPosition, float zoom, glm::ve
     return worldPosition;
 }
 
+ViewTransform ImGuiManager::getViewTransform(float zoom, glm::vec2 cameraTopLeft) const
+{
+    return ViewTransform::create(zoom, cameraTopLeft, getUiScale());
+}
+
+void ImGuiManager::worldToScreen(
+    std::span<const glm::vec2> worldPositions,
+    std::span<ImVec2> screenPositions,
+    float zoom,
+    glm::vec2 cameraTopLeft) const
+{
+    ::worldToScreen(getViewTransform(zoom, cameraTopLeft), worldPositions, screenPositions);
+}
+
+void ImGuiManager::screenToWorld(
+    std::span<const ImVec2> screenPositions,
+    std::span<glm::vec2> worldPositions,
+    float zoom,
+    glm::vec2 cameraTopLeft) const
+{
+    ::screenToWorld(getViewTransform(zoom, cameraTopLeft), screenPositions, worldPositions);
+}
+
 void ImGuiManager::resize(int windowWidth, int windowHeight)
 {
     if (windowWidth <= 0.0f)
@@ -65,17 +139,46 @@ void ImGuiManager::resize(int windowWidth, int windowHeight)
     if (windowHeight <= 0.0f)
         throw std::invalid_argument("windowHeight must be positive");
 
+    if (windowWidth == this->windowWidth && windowHeight == this->windowHeight)
+        return;
+
     this->windowWidth = windowWidth;
     this->windowHeight = windowHeight;
+    layoutDirty = true;
 }
 
 glm::vec2 ImGuiManager::getUiScale() const
 {
-    ImVec2 displaySize = getUiDimensions();
-    return glm::vec2(windowWidth, windowHeight) / glm::vec2(displaySize.x, displaySize.y);
+    return layout.scale;
 }
 
 ImVec2 ImGuiManager::getUiDimensions() const
 {
-    return getIO().DisplaySize;
+    return layout.size;
+}
+
+const UiLayout &ImGuiManager::getLayout() const
+{
+    return layout;
+}
+
+void ImGuiManager::refreshLayout()
+{
+    const ImGuiViewport *viewport = ImGui::GetMainViewport();
+    bool viewportChanged =
+        viewport->Pos.x != layout.position.x || viewport->Pos.y != layout.position.y ||
+        viewport->Size.x != layout.size.x || viewport->Size.y != layout.size.y;
+    if (!layoutDirty && !viewportChanged)
+        return;
+
+    // A minimized window reports a 0x0 display; keep the last real layout
+    // rather than dividing by it.
+    if (viewport->Size.x <= 0.0f || viewport->Size.y <= 0.0f)
+        return;
+
+    layout.position = viewport->Pos;
+    layout.size = viewport->Size;
+    layout.scale = glm::vec2(windowWidth, windowHeight) / glm::vec2(viewport->Size.x, viewport->Size.y);
+    ++layout.generation;
+    layoutDirty = false;
 }
\ No newline at end of file
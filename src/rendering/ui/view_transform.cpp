@@ -0,0 +1,202 @@
+#include <stdexcept>
+#include <string>
+#include "rendering/ui/view_transform.hpp"
+
+// AVX is used unconditionally when the build targets it. Otherwise GCC and
+// Clang on x86 compile the AVX loop for that function alone and pick it at
+// run time, so a baseline build still uses AVX on CPUs that have it.
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VIEW_TRANSFORM_AVX
+#define VIEW_TRANSFORM_AVX_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define VIEW_TRANSFORM_AVX
+#define VIEW_TRANSFORM_AVX_DISPATCH
+#define VIEW_TRANSFORM_AVX_TARGET __attribute__((target("avx")))
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define VIEW_TRANSFORM_SSE
+#endif
+
+static_assert(sizeof(glm::vec2) == 2 * sizeof(float));
+static_assert(sizeof(ImVec2) == 2 * sizeof(float));
+
+namespace
+{
+    enum class Direction
+    {
+        ToScreen, // (p - origin) * scale
+        ToWorld   // p * scale + origin
+    };
+
+    bool useAvx()
+    {
+#if defined(VIEW_TRANSFORM_AVX_DISPATCH)
+        static const bool supported = __builtin_cpu_supports("avx");
+        return supported;
+#elif defined(VIEW_TRANSFORM_AVX)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+#if defined(VIEW_TRANSFORM_AVX)
+    // Returns how many floats it converted, always a multiple of eight.
+    template <Direction direction>
+    VIEW_TRANSFORM_AVX_TARGET size_t transformFloatsAvx(
+        const float *in,
+        float *out,
+        size_t count,
+        float originA,
+        float originB,
+        float scaleA,
+        float scaleB)
+    {
+        const __m256 origin = _mm256_setr_ps(originA, originB, originA, originB, originA, originB, originA, originB);
+        const __m256 scale = _mm256_setr_ps(scaleA, scaleB, scaleA, scaleB, scaleA, scaleB, scaleA, scaleB);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 p = _mm256_loadu_ps(in + i);
+            if constexpr (direction == Direction::ToScreen)
+                p = _mm256_mul_ps(_mm256_sub_ps(p, origin), scale);
+            else
+                p = _mm256_add_ps(_mm256_mul_ps(p, scale), origin);
+            _mm256_storeu_ps(out + i, p);
+        }
+        return i;
+    }
+#endif
+
+    // Works on a flat float stream whose even and odd elements take the
+    // a and b constants. Interleaved points pass x and y as a and b; a
+    // single SoA array passes the same axis twice. Wide loads start on even
+    // elements, so the pattern in each register always lines up.
+    template <Direction direction>
+    void transformFloats(
+        const float *in,
+        float *out,
+        size_t count,
+        float originA,
+        float originB,
+        float scaleA,
+        float scaleB)
+    {
+        size_t i = 0;
+#if defined(VIEW_TRANSFORM_AVX)
+        if (useAvx())
+            i = transformFloatsAvx<direction>(in, out, count, originA, originB, scaleA, scaleB);
+#endif
+#if defined(VIEW_TRANSFORM_SSE)
+        const __m128 origin = _mm_setr_ps(originA, originB, originA, originB);
+        const __m128 scale = _mm_setr_ps(scaleA, scaleB, scaleA, scaleB);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 p = _mm_loadu_ps(in + i);
+            if constexpr (direction == Direction::ToScreen)
+                p = _mm_mul_ps(_mm_sub_ps(p, origin), scale);
+            else
+                p = _mm_add_ps(_mm_mul_ps(p, scale), origin);
+            _mm_storeu_ps(out + i, p);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            float origin = i % 2 ? originB : originA;
+            float scale = i % 2 ? scaleB : scaleA;
+            if constexpr (direction == Direction::ToScreen)
+                out[i] = (in[i] - origin) * scale;
+            else
+                out[i] = in[i] * scale + origin;
+        }
+    }
+
+    void checkSizes(const char *function, size_t inputSize, size_t outputSize)
+    {
+        if (inputSize != outputSize)
+            throw std::invalid_argument(std::string(function) + ": output size does not match input size");
+    }
+}
+
+ViewTransform ViewTransform::create(float zoom, glm::vec2 cameraTopLeft, glm::vec2 uiScale)
+{
+    if (zoom <= 0.0f)
+        throw std::invalid_argument("ViewTransform: zoom must be positive");
+
+    return ViewTransform{cameraTopLeft, glm::vec2(zoom) / uiScale, uiScale / zoom};
+}
+
+void worldToScreen(const ViewTransform &transform, std::span<const glm::vec2> world, std::span<ImVec2> screen)
+{
+    checkSizes("worldToScreen", world.size(), screen.size());
+    transformFloats<Direction::ToScreen>(
+        reinterpret_cast<const float *>(world.data()),
+        reinterpret_cast<float *>(screen.data()),
+        world.size() * 2,
+        transform.cameraTopLeft.x,
+        transform.cameraTopLeft.y,
+        transform.worldToScreenScale.x,
+        transform.worldToScreenScale.y);
+}
+
+void screenToWorld(const ViewTransform &transform, std::span<const ImVec2> screen, std::span<glm::vec2> world)
+{
+    checkSizes("screenToWorld", screen.size(), world.size());
+    transformFloats<Direction::ToWorld>(
+        reinterpret_cast<const float *>(screen.data()),
+        reinterpret_cast<float *>(world.data()),
+        screen.size() * 2,
+        transform.cameraTopLeft.x,
+        transform.cameraTopLeft.y,
+        transform.screenToWorldScale.x,
+        transform.screenToWorldScale.y);
+}
+
+void worldToScreen(
+    const ViewTransform &transform,
+    std::span<const float> worldX,
+    std::span<const float> worldY,
+    std::span<float> screenX,
+    std::span<float> screenY)
+{
+    checkSizes("worldToScreen", worldX.size(), worldY.size());
+    checkSizes("worldToScreen", worldX.size(), screenX.size());
+    checkSizes("worldToScreen", worldY.size(), screenY.size());
+
+    float originX = transform.cameraTopLeft.x, originY = transform.cameraTopLeft.y;
+    float scaleX = transform.worldToScreenScale.x, scaleY = transform.worldToScreenScale.y;
+    transformFloats<Direction::ToScreen>(worldX.data(), screenX.data(), worldX.size(), originX, originX, scaleX, scaleX);
+    transformFloats<Direction::ToScreen>(worldY.data(), screenY.data(), worldY.size(), originY, originY, scaleY, scaleY);
+}
+
+void screenToWorld(
+    const ViewTransform &transform,
+    std::span<const float> screenX,
+    std::span<const float> screenY,
+    std::span<float> worldX,
+    std::span<float> worldY)
+{
+    checkSizes("screenToWorld", screenX.size(), screenY.size());
+    checkSizes("screenToWorld", screenX.size(), worldX.size());
+    checkSizes("screenToWorld", screenY.size(), worldY.size());
+
+    float originX = transform.cameraTopLeft.x, originY = transform.cameraTopLeft.y;
+    float scaleX = transform.screenToWorldScale.x, scaleY = transform.screenToWorldScale.y;
+    transformFloats<Direction::ToWorld>(screenX.data(), worldX.data(), screenX.size(), originX, originX, scaleX, scaleX);
+    transformFloats<Direction::ToWorld>(screenY.data(), worldY.data(), screenY.size(), originY, originY, scaleY, scaleY);
+}
+
+const char *getViewTransformIsa()
+{
+    if (useAvx())
+        return "AVX";
+#if defined(VIEW_TRANSFORM_SSE)
+    return "SSE";
+#else
+    return "scalar";
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "core/block_pool.hpp"
+#include "game/states/game_state.hpp"
+#include "game/states/pooled_state.hpp"
+#include "game/states/state_stack.hpp"
+
+namespace
+{
+    class PooledDummyState : public GameState, public Pooled<PooledDummyState>
+    {
+    public:
+        int payload[16] = {};
+    };
+
+    class DerivedPooledDummyState : public PooledDummyState
+    {
+    public:
+        int extraPayload[16] = {};
+    };
+}
+
+TEST_CASE("BlockPool rejects invalid arguments", "[BlockPool]")
+{
+    REQUIRE_THROWS_WITH(BlockPool(0, 8), "BlockPool: blockSize must be positive");
+    REQUIRE_THROWS_WITH(BlockPool(16, 3), "BlockPool: blockAlignment must be a power of two");
+    REQUIRE_THROWS_WITH(BlockPool(16, 8, 0), "BlockPool: blocksPerChunk must be positive");
+}
+
+TEST_CASE("BlockPool reuses freed blocks", "[BlockPool]")
+{
+    BlockPool pool(24, 8, 4);
+    void *first = pool.allocate();
+    REQUIRE(pool.getLiveCount() == 1);
+    REQUIRE(pool.getCapacity() == 4);
+
+    pool.deallocate(first);
+    REQUIRE(pool.getLiveCount() == 0);
+    REQUIRE(pool.allocate() == first);
+}
+
+TEST_CASE("BlockPool grows by whole chunks with aligned, distinct blocks", "[BlockPool]")
+{
+    BlockPool pool(40, 64, 3);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 10; ++i)
+        blocks.push_back(pool.allocate());
+
+    REQUIRE(pool.getCapacity() == 12);
+    REQUIRE(pool.getLiveCount() == 10);
+    REQUIRE(std::set<void *>(blocks.begin(), blocks.end()).size() == blocks.size());
+    for (void *block : blocks)
+        REQUIRE(reinterpret_cast<std::uintptr_t>(block) % 64 == 0);
+
+    for (void *block : blocks)
+        pool.deallocate(block);
+    REQUIRE(pool.getLiveCount() == 0);
+    REQUIRE(pool.getCapacity() == 12);
+}
+
+TEST_CASE("Pooled states reuse their slot across push and pop", "[BlockPool]")
+{
+    BlockPool &pool = Pooled<PooledDummyState>::getPool();
+    size_t liveBefore = pool.getLiveCount();
+
+    StateStack stack;
+    auto state = std::make_unique<PooledDummyState>();
+    const GameState *firstAddress = state.get();
+    stack.push(std::move(state));
+    REQUIRE(pool.getLiveCount() == liveBefore + 1);
+
+    stack.pop();
+    REQUIRE(pool.getLiveCount() == liveBefore);
+
+    stack.push(std::make_unique<PooledDummyState>());
+    REQUIRE(&stack.top() == firstAddress);
+    stack.pop();
+
+    auto derived = std::make_unique<DerivedPooledDummyState>();
+    REQUIRE(pool.getLiveCount() == liveBefore);
+}
\ No newline at end of file
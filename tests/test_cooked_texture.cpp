@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "core/mapped_file.hpp"
+#include "rendering/block_compression.hpp"
+#include "rendering/cooked_texture.hpp"
+
+namespace
+{
+    std::vector<unsigned char> makeCheckerboard(int width, int height)
+    {
+        std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                unsigned char value = ((x + y) % 2) ? 255 : 0;
+                unsigned char *pixel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+                pixel[0] = pixel[1] = pixel[2] = value;
+                pixel[3] = 255;
+            }
+        }
+        return pixels;
+    }
+}
+
+TEST_CASE("BC1 keeps solid blocks exact and two-colour blocks close", "[BlockCompression]")
+{
+    std::vector<unsigned char> solid(64);
+    for (int i = 0; i < 16; ++i)
+    {
+        solid[i * 4 + 0] = 255;
+        solid[i * 4 + 1] = 0;
+        solid[i * 4 + 2] = 255;
+        solid[i * 4 + 3] = 255;
+    }
+
+    unsigned char block[8], decoded[64];
+    encodeBC1Block(solid.data(), block);
+    decodeBC1Block(block, decoded);
+    REQUIRE(std::vector<unsigned char>(decoded, decoded + 64) == solid);
+
+    std::vector<unsigned char> checkerboard = makeCheckerboard(4, 4);
+    encodeBC1Block(checkerboard.data(), block);
+    decodeBC1Block(block, decoded);
+    for (int i = 0; i < 64; ++i)
+        REQUIRE(std::abs(decoded[i] - checkerboard[i]) <= 16);
+}
+
+TEST_CASE("BC3 keeps alpha endpoints exact", "[BlockCompression]")
+{
+    std::vector<unsigned char> pixels(64, 128);
+    for (int i = 0; i < 16; ++i)
+        pixels[i * 4 + 3] = (i % 2) ? 255 : 0;
+
+    unsigned char block[16], decoded[64];
+    encodeBC3Block(pixels.data(), block);
+    decodeBC3Block(block, decoded);
+    for (int i = 0; i < 16; ++i)
+        REQUIRE(decoded[i * 4 + 3] == pixels[i * 4 + 3]);
+}
+
+TEST_CASE("CookedTexture round-trips a cooked mip chain", "[CookedTexture]")
+{
+    std::vector<unsigned char> pixels = makeCheckerboard(10, 6);
+    CookedTexture cookedTexture(CookedTexture::cook(10, 6, pixels.data(), CookedTextureFormat::RGBA8, true));
+
+    REQUIRE(cookedTexture.getFormat() == CookedTextureFormat::RGBA8);
+    REQUIRE(cookedTexture.getWidth() == 10);
+    REQUIRE(cookedTexture.getHeight() == 6);
+    REQUIRE(cookedTexture.getMipCount() == 4);
+    REQUIRE(cookedTexture.getMip(3).width == 1);
+    REQUIRE(cookedTexture.getMip(3).height == 1);
+    REQUIRE(std::vector<unsigned char>(cookedTexture.getMip(0).data, cookedTexture.getMip(0).data + pixels.size()) == pixels);
+    REQUIRE_THROWS_AS(cookedTexture.getMip(4), std::out_of_range);
+}
+
+TEST_CASE("CookedTexture sizes block-compressed mips by whole blocks", "[CookedTexture]")
+{
+    std::vector<unsigned char> pixels = makeCheckerboard(5, 5);
+    CookedTexture cookedTexture(CookedTexture::cook(5, 5, pixels.data(), CookedTextureFormat::BC3, false));
+    REQUIRE(cookedTexture.getMipCount() == 1);
+    REQUIRE(cookedTexture.getMip(0).byteSize == 4 * 16);
+}
+
+TEST_CASE("CookedTexture rejects corrupt data", "[CookedTexture]")
+{
+    REQUIRE_THROWS_WITH(CookedTexture(std::vector<unsigned char>(4)), "CookedTexture: file is too small");
+
+    std::vector<unsigned char> pixels = makeCheckerboard(4, 4);
+    std::vector<unsigned char> bytes = CookedTexture::cook(4, 4, pixels.data(), CookedTextureFormat::BC1, false);
+    bytes[0] = 'X';
+    REQUIRE_THROWS_WITH(CookedTexture(bytes), "CookedTexture: bad magic");
+
+    bytes = CookedTexture::cook(4, 4, pixels.data(), CookedTextureFormat::BC1, false);
+    bytes.resize(bytes.size() - 1);
+    REQUIRE_THROWS_WITH(CookedTexture(bytes), "CookedTexture: corrupt mip table");
+}
+
+TEST_CASE("CookedTexture reads a cooked file through a memory map", "[CookedTexture]")
+{
+    std::vector<unsigned char> pixels = makeCheckerboard(8, 8);
+    std::vector<unsigned char> bytes = CookedTexture::cook(8, 8, pixels.data(), CookedTextureFormat::BC1, true);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "gamestate_test_texture.gtex";
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    {
+        MappedFile mappedFile(path.string());
+        REQUIRE(mappedFile.size() == bytes.size());
+        REQUIRE(std::vector<unsigned char>(mappedFile.data(), mappedFile.data() + mappedFile.size()) == bytes);
+
+        CookedTexture cookedTexture(path.string());
+        REQUIRE(cookedTexture.getFormat() == CookedTextureFormat::BC1);
+        REQUIRE(cookedTexture.getMipCount() == 4);
+        REQUIRE(CookedTexture::isCookedPath(path.string()));
+    }
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_WITH(MappedFile(path.string()), "MappedFile: failed to open " + path.string());
+}
\ No newline at end of file
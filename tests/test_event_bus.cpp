@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <thread>
+#include <vector>
+#include "core/event_bus.hpp"
+
+namespace
+{
+    struct Ping
+    {
+        int value;
+    };
+
+    struct Pong
+    {
+        int value;
+    };
+
+    struct Tagged
+    {
+        int producer,
+            sequence;
+    };
+}
+
+TEST_CASE("EventBus publishes to subscribers of the event type until they unsubscribe", "[EventBus]")
+{
+    EventBus bus;
+    int pings = 0, pongs = 0;
+    Subscription pingSubscription = bus.subscribe<Ping>([&](const Ping &ping)
+                                                        { pings += ping.value; });
+    {
+        Subscription pongSubscription = bus.subscribe<Pong>([&](const Pong &pong)
+                                                            { pongs += pong.value; });
+        REQUIRE(bus.getSubscriberCount() == 2);
+        bus.publish(Ping{2});
+        bus.publish(Pong{3});
+    }
+    REQUIRE(bus.getSubscriberCount() == 1);
+    bus.publish(Pong{100});
+    REQUIRE(pings == 2);
+    REQUIRE(pongs == 3);
+
+    // Moving keeps the subscription alive; reset ends it.
+    Subscription moved = std::move(pingSubscription);
+    REQUIRE_FALSE(pingSubscription.isActive());
+    bus.publish(Ping{1});
+    REQUIRE(pings == 3);
+    moved.reset();
+    bus.publish(Ping{1});
+    REQUIRE(pings == 3);
+
+    REQUIRE_THROWS_WITH(bus.subscribe<Ping>(nullptr), "EventBus: subscribe received an empty handler");
+}
+
+TEST_CASE("EventBus handlers may unsubscribe themselves and subscribe others mid-publish", "[EventBus]")
+{
+    EventBus bus;
+    int onceCalls = 0, lateCalls = 0;
+    Subscription once, late;
+    once = bus.subscribe<Ping>([&](const Ping &)
+                               {
+                                   ++onceCalls;
+                                   once.reset();
+                                   late = bus.subscribe<Ping>([&](const Ping &)
+                                                              { ++lateCalls; }); });
+
+    bus.publish(Ping{0});
+    REQUIRE(onceCalls == 1);
+    REQUIRE(lateCalls == 0);
+
+    bus.publish(Ping{0});
+    REQUIRE(onceCalls == 1);
+    REQUIRE(lateCalls == 1);
+    REQUIRE(bus.getSubscriberCount() == 1);
+}
+
+TEST_CASE("EventBus delivers queued events only when dispatched, in order", "[EventBus]")
+{
+    EventBus bus;
+    std::vector<int> received;
+    Subscription subscription = bus.subscribe<Ping>([&](const Ping &ping)
+                                                    {
+                                                        received.push_back(ping.value);
+                                                        // Reactions wait for the next dispatch.
+                                                        if (ping.value < 10)
+                                                            bus.enqueue(Ping{ping.value + 10}); });
+
+    REQUIRE(bus.dispatchQueued() == 0);
+    bus.enqueue(Ping{1});
+    bus.enqueue(Ping{2});
+    REQUIRE(received.empty());
+
+    REQUIRE(bus.dispatchQueued() == 2);
+    REQUIRE(received == std::vector<int>{1, 2});
+    REQUIRE(bus.dispatchQueued() == 2);
+    REQUIRE(received == std::vector<int>{1, 2, 11, 12});
+    REQUIRE(bus.dispatchQueued() == 0);
+}
+
+TEST_CASE("EventBus accepts queued events from many threads at once", "[EventBus]")
+{
+    constexpr int producerCount = 4,
+                  eventsPerProducer = 5000;
+
+    EventBus bus;
+    std::vector<int> nextSequence(producerCount, 0);
+    bool ordered = true;
+    Subscription subscription = bus.subscribe<Tagged>([&](const Tagged &event)
+                                                      {
+                                                          ordered = ordered && event.sequence == nextSequence[event.producer];
+                                                          ++nextSequence[event.producer]; });
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < producerCount; ++producer)
+    {
+        producers.emplace_back([&bus, producer]()
+                               {
+                                   for (int sequence = 0; sequence < eventsPerProducer; ++sequence)
+                                       bus.enqueue(Tagged{producer, sequence}); });
+    }
+
+    // Drain while the producers are still going, then mop up.
+    size_t dispatched = 0;
+    while (dispatched < producerCount * eventsPerProducer / 2)
+        dispatched += bus.dispatchQueued();
+    for (auto &producer : producers)
+        producer.join();
+    dispatched += bus.dispatchQueued();
+
+    REQUIRE(dispatched == producerCount * eventsPerProducer);
+    REQUIRE(ordered);
+    for (int count : nextSequence)
+        REQUIRE(count == eventsPerProducer);
+}
\ No newline at end of file
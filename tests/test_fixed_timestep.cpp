@@ -0,0 +1,42 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "game/fixed_timestep.hpp"
+
+TEST_CASE("FixedTimestep rejects invalid settings", "[FixedTimestep]")
+{
+    REQUIRE_THROWS_WITH(FixedTimestep(0.0), "FixedTimestep: tickRate must be positive");
+    REQUIRE_THROWS_WITH(FixedTimestep(60.0, 0), "FixedTimestep: maxCatchUpSteps must be at least 1");
+}
+
+TEST_CASE("FixedTimestep runs one step per elapsed tick", "[FixedTimestep]")
+{
+    FixedTimestep timestep(4.0);
+    REQUIRE(timestep.getStepSize() == 0.25);
+    REQUIRE(timestep.advance(0.125) == 0);
+    REQUIRE(timestep.getAlpha() == 0.5f);
+    REQUIRE(timestep.advance(0.125) == 1);
+    REQUIRE(timestep.getAlpha() == 0.0f);
+    REQUIRE(timestep.advance(0.5) == 2);
+}
+
+TEST_CASE("FixedTimestep runs several ticks per frame when simulating faster than rendering", "[FixedTimestep]")
+{
+    FixedTimestep timestep(8.0);
+    REQUIRE(timestep.advance(0.25) == 2);
+    REQUIRE(timestep.advance(0.375) == 3);
+}
+
+TEST_CASE("FixedTimestep caps catch-up steps and drops the backlog", "[FixedTimestep]")
+{
+    FixedTimestep timestep(4.0, 3);
+    REQUIRE(timestep.advance(10.125) == 3);
+    REQUIRE(timestep.getAlpha() == 0.5f);
+    REQUIRE(timestep.advance(0.125) == 1);
+}
+
+TEST_CASE("FixedTimestep ignores negative frame times", "[FixedTimestep]")
+{
+    FixedTimestep timestep(4.0);
+    REQUIRE(timestep.advance(-1.0) == 0);
+    REQUIRE(timestep.getAlpha() == 0.0f);
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "game/frame_pacer.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("FramePacer rejects invalid rates", "[FramePacer]")
+{
+    FramePacer pacer;
+    REQUIRE_THROWS_WITH(pacer.setFrameRateCap(0.0), "FramePacer: framesPerSecond must be positive");
+    REQUIRE_THROWS_WITH(pacer.setRefreshRate(-60.0), "FramePacer: refreshRate must be positive");
+}
+
+TEST_CASE("FramePacer maps present modes to swap intervals", "[FramePacer]")
+{
+    FramePacer pacer;
+    REQUIRE(pacer.getSwapInterval() == 1);
+
+    pacer.setMode(PresentMode::AdaptiveVsync);
+    REQUIRE(pacer.getSwapInterval() == 1);
+    pacer.setAdaptiveVsyncSupported(true);
+    REQUIRE(pacer.getSwapInterval() == -1);
+
+    pacer.setMode(PresentMode::Uncapped);
+    REQUIRE(pacer.getSwapInterval() == 0);
+    REQUIRE(pacer.getTargetFrameTime() == 0.0);
+
+    pacer.setMode(PresentMode::Capped);
+    pacer.setFrameRateCap(50.0);
+    REQUIRE(pacer.getSwapInterval() == 0);
+    REQUIRE(pacer.getTargetFrameTime() == 0.02);
+}
+
+TEST_CASE("FramePacer counts frames that skip a refresh as missed", "[FramePacer]")
+{
+    FramePacer pacer;
+    pacer.setRefreshRate(100.0);
+
+    auto time = FramePacer::Clock::now();
+    pacer.framePresented(time);
+    pacer.framePresented(time += 10ms);
+    pacer.framePresented(time += 14ms);
+    REQUIRE(pacer.getStats().missedDeadlines == 0);
+
+    pacer.framePresented(time += 20ms);
+    REQUIRE(pacer.getStats().frameCount == 4);
+    REQUIRE(pacer.getStats().missedDeadlines == 1);
+    REQUIRE(pacer.getStats().lastFrameTime == 0.02);
+
+    // Nothing is missed without a deadline, and switching modes starts over.
+    pacer.setMode(PresentMode::Uncapped);
+    REQUIRE(pacer.getStats().frameCount == 0);
+    pacer.framePresented(time);
+    pacer.framePresented(time += 1s);
+    REQUIRE(pacer.getStats().missedDeadlines == 0);
+}
+
+TEST_CASE("FramePacer leaves idle gaps out of its stats", "[FramePacer]")
+{
+    FramePacer pacer;
+    pacer.setRefreshRate(100.0);
+
+    auto time = FramePacer::Clock::now();
+    pacer.framePresented(time);
+    pacer.framePresented(time += 10ms);
+
+    // A background tick sleeps far past the deadline without missing one.
+    pacer.resumeAfterIdle();
+    pacer.framePresented(time += 66ms);
+    REQUIRE(pacer.getStats().frameCount == 3);
+    REQUIRE(pacer.getStats().missedDeadlines == 0);
+    REQUIRE(pacer.getStats().lastFrameTime == 0.01);
+
+    // Only the frame after the wait is skipped.
+    pacer.framePresented(time += 20ms);
+    REQUIRE(pacer.getStats().missedDeadlines == 1);
+}
+
+TEST_CASE("FramePacer holds a capped frame rate", "[FramePacer]")
+{
+    FramePacer pacer;
+    pacer.setMode(PresentMode::Capped);
+    pacer.setFrameRateCap(200.0);
+
+    auto start = FramePacer::Clock::now();
+    for (int i = 0; i < 11; ++i)
+    {
+        pacer.beginFrame();
+        pacer.waitForPresent();
+        pacer.framePresented();
+    }
+    auto elapsed = FramePacer::Clock::now() - start;
+
+    // The first frame sets the cadence; the other ten wait 5 ms each.
+    REQUIRE(elapsed >= 50ms);
+    REQUIRE(pacer.getStats().frameCount == 11);
+}
+
+TEST_CASE("FramePacer waitUntil does not return early", "[FramePacer]")
+{
+    auto deadline = FramePacer::Clock::now() + 3ms;
+    FramePacer::waitUntil(deadline);
+    REQUIRE(FramePacer::Clock::now() >= deadline);
+}
\ No newline at end of file
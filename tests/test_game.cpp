@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "game/game.hpp"
+
+namespace
+{
+    class CountingState : public GameState
+    {
+    public:
+        CountingState(Game &game, int *updates, int *renders, int popAfter = 0)
+            : GameState(game), updates(updates), renders(renders), popAfter(popAfter)
+        {
+        }
+
+        void update(float dt) override
+        {
+            ++*updates;
+            if (*updates == popAfter)
+                game->getStateStack().pop();
+        }
+
+        void render(float alpha) override
+        {
+            ++*renders;
+        }
+
+    private:
+        int *updates, *renders;
+        int popAfter;
+    };
+
+    class ResourceHoldingState : public GameState
+    {
+    public:
+        ResourceHoldingState(Game &game, bool *exitedWithResources)
+            : GameState(game), exitedWithResources(exitedWithResources)
+        {
+        }
+
+        void onExit() override
+        {
+            // Stands in for a state freeing its textures on the way out;
+            // this runs inside ~Game, so it must not throw.
+            try
+            {
+                game->getImGuiManager();
+                *exitedWithResources = true;
+            }
+            catch (const std::runtime_error &)
+            {
+            }
+        }
+
+    private:
+        bool *exitedWithResources;
+    };
+}
+
+TEST_CASE("Game runs headless without textures", "[Game]")
+{
+    Game game;
+    game.initialize(GameBackend::Headless);
+    REQUIRE(game.getBackend() == GameBackend::Headless);
+    REQUIRE(game.getStateStack().size() == 1);
+    REQUIRE_THROWS_WITH(game.getTextureLoader(), "Game: getTextureLoader called before initialize or in headless mode");
+    REQUIRE_THROWS_WITH(game.getTextureCache(), "Game: getTextureCache called before initialize or in headless mode");
+}
+
+TEST_CASE("Game headless run performs exactly the requested ticks", "[Game]")
+{
+    Game game;
+    game.initialize(GameBackend::Headless);
+
+    int updates = 0, renders = 0;
+    game.getStateStack().push(std::make_unique<CountingState>(game, &updates, &renders));
+    game.run(1000);
+    REQUIRE(updates == 1000);
+    REQUIRE(renders == 1000);
+
+    game.setFixedTimestepEnabled(false);
+    game.run(10);
+    REQUIRE(updates == 1010);
+}
+
+TEST_CASE("Game headless run stops once the stack is empty", "[Game]")
+{
+    Game game;
+    game.initialize(GameBackend::Headless);
+    game.getStateStack().pop();
+
+    int updates = 0, renders = 0;
+    game.getStateStack().push(std::make_unique<CountingState>(game, &updates, &renders, 5));
+    game.run();
+    REQUIRE(updates == 5);
+    REQUIRE(game.getStateStack().isEmpty());
+}
+
+TEST_CASE("Game routes queued input to states before updating them", "[Game]")
+{
+    Game game;
+    game.initialize(GameBackend::Headless);
+    game.getStateStack().pop();
+
+    int updates = 0, renders = 0;
+    game.getStateStack().push(std::make_unique<CountingState>(game, &updates, &renders));
+    game.getStateStack().push(game.makeOptionsState());
+
+    InputEvent escape;
+    escape.code = InputKey::Escape;
+    game.getInput().push(escape);
+    game.run(2);
+
+    // Escape closed the options overlay, which blocked it from the state below.
+    REQUIRE(game.getStateStack().size() == 1);
+    REQUIRE(game.getInput().getPendingCount() == 0);
+
+    InputEvent f3;
+    f3.code = InputKey::F3;
+    game.getInput().push(f3);
+    game.run(1);
+    REQUIRE(game.getProfiler().isEnabled());
+}
+
+TEST_CASE("Game keeps input a UI widget captured from the states", "[Game]")
+{
+    Game game;
+    game.initialize(GameBackend::Headless);
+    game.getStateStack().push(game.makeOptionsState());
+    size_t depth = game.getStateStack().size();
+
+    InputEvent escape;
+    escape.code = InputKey::Escape;
+
+    // As if a text field had focus: Escape belongs to the field.
+    game.getImGuiManager().getIO().WantCaptureKeyboard = true;
+    game.getInput().push(escape);
+    game.run(1);
+    REQUIRE(game.getStateStack().size() == depth);
+
+    game.getImGuiManager().getIO().WantCaptureKeyboard = false;
+    game.getInput().push(escape);
+    game.run(2);
+    REQUIRE(game.getStateStack().size() == depth - 1);
+}
+
+TEST_CASE("Game releases its states before the resources they use", "[Game]")
+{
+    bool exitedWithResources = false;
+    {
+        Game game;
+        game.initialize(GameBackend::Headless);
+        game.getStateStack().push(std::make_unique<ResourceHoldingState>(game, &exitedWithResources));
+    }
+    REQUIRE(exitedWithResources);
+}
\ No newline at end of file
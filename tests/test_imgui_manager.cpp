@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/ui/imgui_manager.hpp"
+
+TEST_CASE("ImGuiManager bumps the layout generation only when the layout changes", "[ImGuiManager]")
+{
+    ImGuiManager imGuiManager(nullptr, 800, 600);
+    imGuiManager.newFrame();
+    imGuiManager.renderFrame();
+
+    const UiLayout &layout = imGuiManager.getLayout();
+    uint64_t generation = layout.generation;
+    REQUIRE(generation > 0);
+    REQUIRE(layout.size.x == 800.0f);
+    REQUIRE(layout.size.y == 600.0f);
+    REQUIRE(imGuiManager.getUiScale() == glm::vec2(1.0f));
+
+    imGuiManager.newFrame();
+    imGuiManager.renderFrame();
+    REQUIRE(layout.generation == generation);
+
+    // Resizing to the same size is not a change.
+    imGuiManager.resize(800, 600);
+    imGuiManager.newFrame();
+    imGuiManager.renderFrame();
+    REQUIRE(layout.generation == generation);
+
+    imGuiManager.resize(1024, 768);
+    REQUIRE(layout.generation == generation);
+    imGuiManager.newFrame();
+    imGuiManager.renderFrame();
+    REQUIRE(layout.generation == generation + 1);
+    REQUIRE(layout.size.x == 1024.0f);
+
+    ImVec2 centered = layout.getCenteredPosition(ImVec2(200.0f, 100.0f));
+    REQUIRE(centered.x == 412.0f);
+    REQUIRE(centered.y == 334.0f);
+}
\ No newline at end of file
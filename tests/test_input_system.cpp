@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <cstdint>
+#include <thread>
+#include "core/spsc_ring.hpp"
+#include "input/input_system.hpp"
+
+TEST_CASE("SpscRing rounds its capacity up and rejects pushes when full", "[SpscRing]")
+{
+    REQUIRE_THROWS_WITH(SpscRing<int>(0), "SpscRing: capacity must be positive");
+
+    SpscRing<int> ring(3);
+    REQUIRE(ring.getCapacity() == 4);
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(ring.tryPush(i));
+    REQUIRE_FALSE(ring.tryPush(4));
+    REQUIRE(ring.size() == 4);
+
+    int value = -1;
+    REQUIRE(ring.tryPop(value));
+    REQUIRE(value == 0);
+    REQUIRE(ring.tryPush(4));
+
+    for (int expected = 1; expected <= 4; ++expected)
+    {
+        REQUIRE(ring.tryPop(value));
+        REQUIRE(value == expected);
+    }
+    REQUIRE_FALSE(ring.tryPop(value));
+}
+
+TEST_CASE("SpscRing delivers every value in order across threads", "[SpscRing]")
+{
+    constexpr uint64_t valueCount = 200000;
+    SpscRing<uint64_t> ring(64);
+
+    std::thread producer([&ring]
+                         {
+        for (uint64_t i = 0; i < valueCount;)
+        {
+            if (ring.tryPush(i))
+                ++i;
+        } });
+
+    uint64_t expected = 0, value = 0;
+    bool inOrder = true;
+    while (expected < valueCount)
+    {
+        if (!ring.tryPop(value))
+            continue;
+
+        inOrder &= value == expected;
+        ++expected;
+    }
+    producer.join();
+
+    REQUIRE(inOrder);
+}
+
+TEST_CASE("InputSystem queues events in order and counts drops", "[InputSystem]")
+{
+    InputSystem input(2);
+    for (int key = 1; key <= 3; ++key)
+    {
+        InputEvent event;
+        event.code = key;
+        event.time = key * 0.5;
+        input.push(event);
+    }
+    REQUIRE(input.getPendingCount() == 2);
+    REQUIRE(input.getDroppedCount() == 1);
+
+    InputEvent event;
+    REQUIRE(input.pop(event));
+    REQUIRE(event.isKeyPress(1));
+    REQUIRE(event.time == 0.5);
+    REQUIRE(input.pop(event));
+    REQUIRE(event.isKeyPress(2));
+    REQUIRE_FALSE(input.pop(event));
+}
\ No newline at end of file
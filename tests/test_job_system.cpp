@@ -0,0 +1,81 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <stdexcept>
+#include <vector>
+#include "core/job_system.hpp"
+
+TEST_CASE("JobSystem rejects invalid arguments", "[JobSystem]")
+{
+    REQUIRE_THROWS_WITH(JobSystem(0), "JobSystem: workerCount must be positive");
+
+    JobSystem jobSystem(1);
+    JobGroup group;
+    REQUIRE_THROWS_WITH(jobSystem.run(group, nullptr), "JobSystem: run received empty job");
+    REQUIRE_THROWS_WITH(jobSystem.parallelFor(1, 1, nullptr), "JobSystem: parallelFor received empty body");
+}
+
+TEST_CASE("JobSystem waits for every job in a group", "[JobSystem]")
+{
+    JobSystem jobSystem(3);
+    REQUIRE(jobSystem.getWorkerCount() == 3);
+
+    std::atomic<int> completed = 0;
+    JobGroup group;
+    for (int i = 0; i < 1000; ++i)
+        jobSystem.run(group, [&completed]()
+                      { ++completed; });
+    jobSystem.wait(group);
+
+    REQUIRE(group.isDone());
+    REQUIRE(completed == 1000);
+}
+
+TEST_CASE("JobSystem lets jobs spawn and wait for nested jobs", "[JobSystem]")
+{
+    JobSystem jobSystem(2);
+    std::atomic<int> completed = 0;
+
+    JobGroup outer;
+    for (int i = 0; i < 8; ++i)
+    {
+        jobSystem.run(outer, [&jobSystem, &completed]()
+                      {
+            JobGroup inner;
+            for (int j = 0; j < 8; ++j)
+                jobSystem.run(inner, [&completed]()
+                              { ++completed; });
+            jobSystem.wait(inner); });
+    }
+    jobSystem.wait(outer);
+
+    REQUIRE(completed == 64);
+}
+
+TEST_CASE("JobSystem parallelFor covers every index exactly once", "[JobSystem]")
+{
+    JobSystem jobSystem(4);
+    std::vector<std::atomic<int>> hits(1003);
+    jobSystem.parallelFor(hits.size(), 64, [&hits](size_t begin, size_t end)
+                          {
+        for (size_t i = begin; i < end; ++i)
+            ++hits[i]; });
+
+    for (const auto &hit : hits)
+        REQUIRE(hit == 1);
+
+    int calls = 0;
+    jobSystem.parallelFor(0, 64, [&calls](size_t, size_t)
+                          { ++calls; });
+    REQUIRE(calls == 0);
+}
+
+TEST_CASE("JobSystem rethrows the first job exception from wait", "[JobSystem]")
+{
+    JobSystem jobSystem(2);
+    JobGroup group;
+    jobSystem.run(group, []()
+                  { throw std::runtime_error("job failed"); });
+    REQUIRE_THROWS_WITH(jobSystem.wait(group), "job failed");
+    REQUIRE(group.isDone());
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "core/profiler.hpp"
+
+TEST_CASE("Profiler rejects an empty history", "[Profiler]")
+{
+    REQUIRE_THROWS_WITH(Profiler(0), "Profiler: historySize must be positive");
+}
+
+TEST_CASE("Profiler records nothing while disabled", "[Profiler]")
+{
+    Profiler profiler;
+    REQUIRE_FALSE(profiler.isEnabled());
+
+    {
+        ProfileScope scope(&profiler, "Game", "update");
+    }
+    profiler.record("Game", "render", 0.5);
+    profiler.beginFrame();
+
+    REQUIRE(profiler.getStats().empty());
+
+    ProfileScope nullScope(nullptr, "Game", "update");
+}
+
+TEST_CASE("Profiler sums a section within a frame", "[Profiler]")
+{
+    Profiler profiler;
+    profiler.setEnabled(true);
+
+    profiler.record("Game", "update", 0.25);
+    profiler.record("Game", "update", 0.5);
+    profiler.beginFrame();
+
+    auto stats = profiler.getStats();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].label == "Game::update");
+    REQUIRE(stats[0].cpu.sampleCount == 1);
+    REQUIRE(stats[0].cpu.last == 0.75);
+}
+
+TEST_CASE("Profiler reports percentiles over a rolling window", "[Profiler]")
+{
+    Profiler profiler(100);
+    profiler.setEnabled(true);
+
+    for (int frame = 1; frame <= 150; ++frame)
+    {
+        profiler.record("Frame", nullptr, frame);
+        profiler.beginFrame();
+    }
+
+    auto stats = profiler.getStats();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].label == "Frame");
+    REQUIRE(stats[0].cpu.sampleCount == 100);
+    REQUIRE(stats[0].cpu.last == 150);
+    REQUIRE(stats[0].cpu.p50 == 101);
+    REQUIRE(stats[0].cpu.p95 == 145);
+    REQUIRE(stats[0].cpu.p99 == 149);
+}
+
+TEST_CASE("Profiler keeps the history of sections that skip a frame", "[Profiler]")
+{
+    Profiler profiler;
+    profiler.setEnabled(true);
+
+    profiler.record("PlayState", "update", 1.0);
+    profiler.beginFrame();
+    profiler.beginFrame();
+
+    auto stats = profiler.getStats();
+    REQUIRE(stats[0].cpu.sampleCount == 1);
+    REQUIRE(stats[0].cpu.p99 == 1.0);
+
+    profiler.setEnabled(false);
+    profiler.setEnabled(true);
+    REQUIRE(profiler.getStats().empty());
+}
+
+TEST_CASE("Profiler reports GPU timings next to CPU timings", "[Profiler]")
+{
+    Profiler profiler;
+    profiler.setEnabled(true);
+
+    profiler.record("Game", "render", 0.002);
+    profiler.recordGpu("Game", "render", 0.005);
+    profiler.recordGpu("ImGuiManager", "renderFrame", 0.001);
+    profiler.beginFrame();
+
+    auto stats = profiler.getStats();
+    REQUIRE(stats.size() == 2);
+    REQUIRE(stats[0].label == "Game::render");
+    REQUIRE(stats[0].cpu.last == 0.002);
+    REQUIRE(stats[0].gpu.last == 0.005);
+    REQUIRE(stats[1].cpu.sampleCount == 0);
+    REQUIRE(stats[1].gpu.sampleCount == 1);
+}
\ No newline at end of file
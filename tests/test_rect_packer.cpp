@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <vector>
+#include "rendering/rect_packer.hpp"
+
+namespace
+{
+    bool overlaps(const PackedRect &a, const PackedRect &b)
+    {
+        return a.x < b.x + b.width && b.x < a.x + a.width &&
+               a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+}
+
+TEST_CASE("RectPacker rejects invalid dimensions", "[RectPacker]")
+{
+    REQUIRE_THROWS_WITH(RectPacker(0, 16), "RectPacker: dimensions must be positive");
+    RectPacker packer(16, 16);
+    PackedRect packed;
+    REQUIRE_THROWS_WITH(packer.pack(0, 4, packed), "RectPacker: rect dimensions must be positive");
+}
+
+TEST_CASE("RectPacker packs rects inside the page without overlap", "[RectPacker]")
+{
+    RectPacker packer(64, 64);
+    std::vector<PackedRect> rects;
+    const int sizes[][2] = {{32, 16}, {16, 16}, {16, 8}, {20, 30}, {8, 8}, {12, 4}, {30, 10}};
+    for (const auto &size : sizes)
+    {
+        PackedRect packed;
+        REQUIRE(packer.pack(size[0], size[1], packed));
+        REQUIRE(packed.x >= 0);
+        REQUIRE(packed.y >= 0);
+        REQUIRE(packed.x + packed.width <= 64);
+        REQUIRE(packed.y + packed.height <= 64);
+        for (const auto &other : rects)
+            REQUIRE_FALSE(overlaps(packed, other));
+        rects.push_back(packed);
+    }
+}
+
+TEST_CASE("RectPacker fills a page exactly with equal tiles", "[RectPacker]")
+{
+    RectPacker packer(32, 32);
+    PackedRect packed;
+    for (int i = 0; i < 16; ++i)
+        REQUIRE(packer.pack(8, 8, packed));
+
+    REQUIRE(packer.getOccupancy() == 1.0f);
+    REQUIRE_FALSE(packer.pack(1, 1, packed));
+
+    packer.reset();
+    REQUIRE(packer.getOccupancy() == 0.0f);
+    REQUIRE(packer.pack(32, 32, packed));
+}
+
+TEST_CASE("RectPacker refuses rects larger than the page", "[RectPacker]")
+{
+    RectPacker packer(16, 16);
+    PackedRect packed;
+    REQUIRE_FALSE(packer.pack(17, 4, packed));
+    REQUIRE_FALSE(packer.pack(4, 17, packed));
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include "game/settings.hpp"
+
+TEST_CASE("Settings round-trip through their INI text", "[Settings]")
+{
+    Settings settings;
+    settings.fullscreen = true;
+    settings.windowWidth = 1280;
+    settings.windowHeight = 720;
+    settings.presentMode = PresentMode::Capped;
+    settings.frameRateCap = 144.5;
+    settings.lateLatch = true;
+
+    Settings parsed = Settings::parse(settings.serialize());
+    REQUIRE(parsed.fullscreen);
+    REQUIRE(parsed.windowWidth == 1280);
+    REQUIRE(parsed.windowHeight == 720);
+    REQUIRE(parsed.presentMode == PresentMode::Capped);
+    REQUIRE(parsed.frameRateCap == 144.5);
+    REQUIRE(parsed.lateLatch);
+}
+
+TEST_CASE("Settings keep defaults for unknown keys and unreadable values", "[Settings]")
+{
+    Settings parsed = Settings::parse(
+        "; comment\r\n"
+        "[display]\r\n"
+        "fullscreen = maybe\r\n"
+        "width = -5\r\n"
+        "height = 900\r\n"
+        "colour = blue\r\n"
+        "no equals sign\r\n"
+        "[frame_pacing]\r\n"
+        "present_mode = warp\r\n"
+        "frame_rate_cap = 75");
+
+    Settings defaults;
+    REQUIRE(parsed.fullscreen == defaults.fullscreen);
+    REQUIRE(parsed.windowWidth == defaults.windowWidth);
+    REQUIRE(parsed.windowHeight == 900);
+    REQUIRE(parsed.presentMode == defaults.presentMode);
+    REQUIRE(parsed.frameRateCap == 75.0);
+
+    // A fresh install paces frames the way the pacer would on its own.
+    REQUIRE(defaults.frameRateCap == FramePacer().getFrameRateCap());
+}
+
+TEST_CASE("SettingsStore batches changes into one write and loads them back", "[Settings]")
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "gamestate_test_settings.ini";
+    std::filesystem::remove(path);
+
+    {
+        SettingsStore store(path.string(), std::chrono::milliseconds(50));
+        REQUIRE_FALSE(store.get().fullscreen);
+
+        for (int width = 801; width <= 810; ++width)
+            store.modify([width](Settings &settings)
+                         { settings.windowWidth = width; });
+        store.modify([](Settings &settings)
+                     { settings.fullscreen = true; });
+        REQUIRE(store.get().windowWidth == 810);
+
+        store.flush();
+        REQUIRE(store.getWriteCount() == 1);
+        REQUIRE(std::filesystem::exists(path));
+
+        // Saved on destruction without an explicit flush.
+        store.modify([](Settings &settings)
+                     { settings.presentMode = PresentMode::Uncapped; });
+    }
+
+    SettingsStore reloaded(path.string());
+    REQUIRE(reloaded.get().fullscreen);
+    REQUIRE(reloaded.get().windowWidth == 810);
+    REQUIRE(reloaded.get().presentMode == PresentMode::Uncapped);
+    REQUIRE(reloaded.getWriteCount() == 0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("SettingsStore without a file keeps changes in memory only", "[Settings]")
+{
+    SettingsStore store;
+    store.modify([](Settings &settings)
+                 { settings.lateLatch = true; });
+    store.flush();
+    REQUIRE(store.get().lateLatch);
+    REQUIRE(store.getWriteCount() == 0);
+}
+
+TEST_CASE("SettingsStore keeps changes in memory when the file cannot be written", "[Settings]")
+{
+    // A file where the settings directory should be makes every write fail.
+    std::filesystem::path blocker = std::filesystem::temp_directory_path() / "gamestate_test_settings_blocker";
+    std::ofstream(blocker) << "not a directory";
+
+    {
+        SettingsStore store((blocker / "settings.ini").string(), std::chrono::milliseconds(1));
+        REQUIRE_NOTHROW(store.modify([](Settings &settings)
+                                     { settings.lateLatch = true; }));
+        REQUIRE(store.get().lateLatch);
+        REQUIRE_THROWS(store.flush());
+        REQUIRE(store.getWriteCount() == 0);
+    }
+    std::filesystem::remove(blocker);
+}
+
+TEST_CASE("SettingsStore starts with defaults when the file cannot be read", "[Settings]")
+{
+    // A directory where the settings file should be cannot be mapped.
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "gamestate_test_settings_directory.ini";
+    std::filesystem::create_directories(path);
+
+    {
+        std::unique_ptr<SettingsStore> store;
+        REQUIRE_NOTHROW(store = std::make_unique<SettingsStore>(path.string()));
+        REQUIRE(store->get().frameRateCap == Settings{}.frameRateCap);
+        REQUIRE(store->get().windowWidth == Settings{}.windowWidth);
+    }
+    std::filesystem::remove(path);
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "rendering/sprite_batch.hpp"
+
+TEST_CASE("SpriteBatch rejects texture 0", "[SpriteBatch]")
+{
+    SpriteBatch batch;
+    batch.begin(glm::vec2(800.0f, 600.0f), glm::ivec2(800, 600));
+    REQUIRE_THROWS_WITH(batch.draw(0, glm::vec2(0.0f), glm::vec2(1.0f)), "SpriteBatch: draw received texture 0");
+}
+
+TEST_CASE("SpriteBatch groups sprites by texture into one draw range each", "[SpriteBatch]")
+{
+    SpriteBatch batch;
+    batch.begin(glm::vec2(800.0f, 600.0f), glm::ivec2(1600, 1200));
+    for (int i = 0; i < 6; ++i)
+        batch.draw(i % 2 ? 7 : 3, glm::vec2(static_cast<float>(i), 0.0f), glm::vec2(1.0f));
+    REQUIRE(batch.size() == 6);
+    batch.end();
+
+    const auto &ranges = batch.getDrawRanges();
+    REQUIRE(ranges.size() == 2);
+    REQUIRE(ranges[0].texture == 3);
+    REQUIRE(ranges[0].first == 0);
+    REQUIRE(ranges[0].count == 3);
+    REQUIRE(ranges[1].texture == 7);
+    REQUIRE(ranges[1].first == 3);
+    REQUIRE(ranges[1].count == 3);
+
+    // Submission order survives within a texture.
+    const auto &instances = batch.getInstances();
+    REQUIRE(instances[0].rect.x == 0.0f);
+    REQUIRE(instances[1].rect.x == 2.0f);
+    REQUIRE(instances[2].rect.x == 4.0f);
+    REQUIRE(instances[3].rect.x == 1.0f);
+    REQUIRE(batch.getFramebufferSize() == glm::ivec2(1600, 1200));
+}
+
+TEST_CASE("SpriteBatch draws lower layers first regardless of texture", "[SpriteBatch]")
+{
+    SpriteBatch batch;
+    batch.begin(glm::vec2(800.0f, 600.0f), glm::ivec2(800, 600));
+    glm::vec4 fullUv(0.0f, 0.0f, 1.0f, 1.0f);
+    batch.draw(1, glm::vec2(0.0f), glm::vec2(1.0f), fullUv, 0xFFFFFFFF, 0.0f, 1);
+    batch.draw(2, glm::vec2(0.0f), glm::vec2(1.0f), fullUv, 0xFFFFFFFF, 0.0f, -1);
+    batch.draw(1, glm::vec2(0.0f), glm::vec2(1.0f), fullUv, 0xFFFFFFFF, 0.0f, -1);
+    batch.end();
+
+    const auto &ranges = batch.getDrawRanges();
+    REQUIRE(ranges.size() == 3);
+    REQUIRE(ranges[0].texture == 1);
+    REQUIRE(ranges[1].texture == 2);
+    REQUIRE(ranges[2].texture == 1);
+}
+
+TEST_CASE("SpriteBatch starts empty again on begin", "[SpriteBatch]")
+{
+    SpriteBatch batch;
+    batch.begin(glm::vec2(800.0f, 600.0f), glm::ivec2(800, 600));
+    batch.draw(1, glm::vec2(0.0f), glm::vec2(1.0f));
+    batch.end();
+    REQUIRE_FALSE(batch.isEmpty());
+
+    batch.begin(glm::vec2(800.0f, 600.0f), glm::ivec2(800, 600));
+    REQUIRE(batch.isEmpty());
+    batch.end();
+    REQUIRE(batch.getDrawRanges().empty());
+}
\ No newline at end of file
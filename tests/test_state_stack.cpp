@@ -1,5 +1,7 @@
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
+#include <vector>
 #include "game/game.hpp"
 
 class DummyState : public GameState
@@ -63,7 +65,7 @@ public:
             *resumedFlag = true;
     }
 
-    void render() override
+    void render(float) override
     {
         if (renderCallCount)
             (*renderCallCount)++;
@@ -453,4 +455,435 @@ TEST_CASE("StateStack updates the top state", "[StateStack]")
     stack.update(0.01f);
     REQUIRE(updatedFlag2);
     REQUIRE_FALSE(updatedFlag1);
+}
+
+class CheckedPopRequestingState : public DummyState
+{
+public:
+    size_t *sizeAfterPop = nullptr;
+    bool *exitedBeforeReturn = nullptr;
+
+    CheckedPopRequestingState(
+        Game &game,
+        size_t *sizeAfterPop,
+        bool *exitedBeforeReturn,
+        bool *exitedFlag)
+        : DummyState(game, nullptr, exitedFlag),
+          sizeAfterPop(sizeAfterPop),
+          exitedBeforeReturn(exitedBeforeReturn)
+    {
+    }
+
+    void update(float) override
+    {
+        StateStack &stack = game->getStateStack();
+        stack.pop();
+        *sizeAfterPop = stack.size();
+        *exitedBeforeReturn = *exitedFlag;
+    }
+};
+
+TEST_CASE("StateStack defers transitions requested during update until update returns", "[StateStack]")
+{
+    Game game;
+    size_t sizeAfterPop = 0;
+    bool exitedBeforeReturn = true,
+         exitedFlag = false;
+    StateStack &stack = game.getStateStack();
+    stack.push(std::make_unique<CheckedPopRequestingState>(
+        game, &sizeAfterPop, &exitedBeforeReturn, &exitedFlag));
+    stack.update(0.01f);
+    REQUIRE(sizeAfterPop == 1);
+    REQUIRE_FALSE(exitedBeforeReturn);
+    REQUIRE(exitedFlag);
+    REQUIRE(stack.isEmpty());
+    REQUIRE_FALSE(stack.hasPendingChanges());
+}
+
+class RenderPopRequestingState : public CheckedPopRequestingState
+{
+public:
+    using CheckedPopRequestingState::CheckedPopRequestingState;
+
+    void update(float) override
+    {
+    }
+
+    void render(float) override
+    {
+        CheckedPopRequestingState::update(0.0f);
+    }
+};
+
+TEST_CASE("StateStack applies transitions requested during render once render returns", "[StateStack]")
+{
+    Game game;
+    size_t sizeAfterPop = 0;
+    bool exitedBeforeReturn = true,
+         exitedFlag = false;
+    StateStack &stack = game.getStateStack();
+    stack.push(std::make_unique<RenderPopRequestingState>(
+        game, &sizeAfterPop, &exitedBeforeReturn, &exitedFlag));
+    stack.render();
+    REQUIRE(sizeAfterPop == 1);
+    REQUIRE_FALSE(exitedBeforeReturn);
+    REQUIRE(exitedFlag);
+    REQUIRE(stack.isEmpty());
+    REQUIRE_FALSE(stack.hasPendingChanges());
+}
+
+class PushPopRequestingState : public DummyState
+{
+public:
+    bool *pushedEnteredFlag = nullptr, *pushedExitedFlag = nullptr;
+
+    PushPopRequestingState(
+        Game &game,
+        bool *pausedFlag,
+        bool *pushedEnteredFlag,
+        bool *pushedExitedFlag)
+        : DummyState(game, nullptr, nullptr, nullptr, nullptr, pausedFlag),
+          pushedEnteredFlag(pushedEnteredFlag),
+          pushedExitedFlag(pushedExitedFlag)
+    {
+    }
+
+    void update(float) override
+    {
+        StateStack &stack = game->getStateStack();
+        stack.push(std::make_unique<DummyState>(*game, pushedEnteredFlag, pushedExitedFlag));
+        stack.pop();
+    }
+};
+
+TEST_CASE("StateStack merges a push followed by a pop in the same batch", "[StateStack]")
+{
+    Game game;
+    bool pausedFlag = false,
+         pushedEntered = false,
+         pushedExited = false;
+    StateStack &stack = game.getStateStack();
+    stack.push(std::make_unique<PushPopRequestingState>(
+        game, &pausedFlag, &pushedEntered, &pushedExited));
+    stack.update(0.01f);
+    REQUIRE(stack.size() == 1);
+    REQUIRE_FALSE(pausedFlag);
+    REQUIRE_FALSE(pushedEntered);
+    REQUIRE_FALSE(pushedExited);
+}
+
+class LoggingState : public GameState
+{
+public:
+    LoggingState(std::vector<std::string> *log, std::string name)
+        : log(log), name(std::move(name))
+    {
+    }
+
+    void onEnter() override { log->push_back(name + ".onEnter"); }
+    void onExit() override { log->push_back(name + ".onExit"); }
+    void onPause() override { log->push_back(name + ".onPause"); }
+    void onResume() override { log->push_back(name + ".onResume"); }
+
+private:
+    std::vector<std::string> *log;
+    std::string name;
+};
+
+class BatchRequestingState : public LoggingState
+{
+public:
+    BatchRequestingState(Game &game, std::vector<std::string> *log)
+        : LoggingState(log, "options"), game(game), log(log)
+    {
+    }
+
+    void update(float) override
+    {
+        StateStack &stack = game.getStateStack();
+        stack.replace(std::make_unique<LoggingState>(log, "first"));
+        stack.push(std::make_unique<LoggingState>(log, "second"));
+    }
+
+private:
+    Game &game;
+    std::vector<std::string> *log;
+};
+
+TEST_CASE("StateStack fires lifecycle hooks of a batch in a deterministic order", "[StateStack]")
+{
+    // Outlives the game, whose states log their onExit as it shuts down.
+    std::vector<std::string> log;
+    Game game;
+    StateStack &stack = game.getStateStack();
+    stack.push(std::make_unique<LoggingState>(&log, "play"));
+    stack.push(std::make_unique<BatchRequestingState>(game, &log));
+    log.clear();
+    stack.update(0.01f);
+    REQUIRE(stack.size() == 3);
+    REQUIRE(log == std::vector<std::string>{
+                       "options.onExit",
+                       "first.onEnter",
+                       "first.onPause",
+                       "second.onEnter"});
+}
+
+class FlaggedState : public DummyState
+{
+public:
+    bool opaque = false,
+         updateWhenCovered = false;
+
+    FlaggedState(
+        Game &game,
+        bool opaque, bool updateWhenCovered,
+        bool *renderedFlag = nullptr, bool *updatedFlag = nullptr)
+        : DummyState(game, nullptr, nullptr, renderedFlag, updatedFlag),
+          opaque(opaque), updateWhenCovered(updateWhenCovered)
+    {
+    }
+
+    bool isOpaque() const override
+    {
+        return opaque;
+    }
+
+    bool updatesWhenCovered() const override
+    {
+        return updateWhenCovered;
+    }
+};
+
+TEST_CASE("StateStack only renders from the topmost opaque state upward", "[StateStack]")
+{
+    Game game;
+    bool hiddenRendered = false,
+         opaqueRendered = false,
+         overlayRendered = false;
+    StateStack &stack = game.getStateStack();
+    stack.push(std::make_unique<FlaggedState>(game, true, false, &hiddenRendered));
+    stack.push(std::make_unique<FlaggedState>(game, true, false, &opaqueRendered));
+    stack.push(std::make_unique<FlaggedState>(game, false, false, &overlayRendered));
+    stack.render();
+    REQUIRE_FALSE(hiddenRendered);
+    REQUIRE(opaqueRendered);
+    REQUIRE(overlayRendered);
+
+    stack.pop();
+    stack.pop();
+    stack.render();
+    REQUIRE(hiddenRendered);
+}
+
+TEST_CASE("StateStack updates covered states that ask for it", "[StateStack]")
+{
+    Game game;
+    bool backgroundUpdated = false,
+         coveredUpdated = false,
+         topUpdated = false;
+    StateStack &stack = game.getStateStack();
+    stack.push(std::make_unique<FlaggedState>(game, true, true, nullptr, &backgroundUpdated));
+    stack.push(std::make_unique<FlaggedState>(game, false, false, nullptr, &coveredUpdated));
+    stack.push(std::make_unique<FlaggedState>(game, false, false, nullptr, &topUpdated));
+    stack.update(0.01f);
+    REQUIRE(backgroundUpdated);
+    REQUIRE_FALSE(coveredUpdated);
+    REQUIRE(topUpdated);
+}
+
+TEST_CASE("StateStack profiles the states it dispatches to", "[StateStack]")
+{
+    Game game;
+    Profiler profiler;
+    profiler.setEnabled(true);
+    StateStack &stack = game.getStateStack();
+    stack.setProfiler(&profiler);
+    stack.push(std::make_unique<FlaggedState>(game, true, false));
+    stack.update(0.01f);
+    stack.render();
+    profiler.beginFrame();
+
+    auto stats = profiler.getStats();
+    REQUIRE(stats.size() == 2);
+    REQUIRE(stats[0].label == "GameState::update");
+    REQUIRE(stats[1].label == "GameState::render");
+}
+
+class ParallelState : public GameState
+{
+public:
+    ParallelState(std::atomic<int> &updates, bool popSelf = false)
+        : updates(updates), popSelf(popSelf)
+    {
+    }
+
+    bool updatesWhenCovered() const override
+    {
+        return true;
+    }
+
+    bool isParallelUpdateSafe() const override
+    {
+        return true;
+    }
+
+    void update(float dt) override
+    {
+        ++updates;
+        if (popSelf)
+            stack->pop();
+    }
+
+    StateStack *stack = nullptr;
+
+private:
+    std::atomic<int> &updates;
+    bool popSelf;
+};
+
+TEST_CASE("StateStack updates parallel-safe states on the job system before returning", "[StateStack]")
+{
+    Game game;
+    JobSystem jobSystem(2);
+    std::atomic<int> updates = 0;
+    bool topUpdated = false;
+    StateStack &stack = game.getStateStack();
+    stack.setJobSystem(&jobSystem);
+
+    for (int i = 0; i < 16; ++i)
+        stack.push(std::make_unique<ParallelState>(updates));
+    stack.push(std::make_unique<DummyState>(game, nullptr, nullptr, nullptr, &topUpdated));
+
+    stack.update(0.01f);
+    REQUIRE(updates == 16);
+    REQUIRE(topUpdated);
+
+    auto popping = std::make_unique<ParallelState>(updates, true);
+    popping->stack = &stack;
+    stack.push(std::move(popping));
+    stack.update(0.01f);
+    REQUIRE(updates == 33);
+    REQUIRE(stack.size() == 17);
+}
+
+class InputState : public GameState
+{
+public:
+    InputState(std::vector<int> &received, int id, bool consumes, bool modal = false)
+        : received(received), id(id), consumes(consumes), modal(modal)
+    {
+    }
+
+    bool blocksInput() const override
+    {
+        return modal;
+    }
+
+    bool handleInput(const InputEvent &event) override
+    {
+        received.push_back(id);
+        return consumes;
+    }
+
+private:
+    std::vector<int> &received;
+    int id;
+    bool consumes, modal;
+};
+
+TEST_CASE("StateStack routes input from the top down until a state consumes it", "[StateStack]")
+{
+    StateStack stack;
+    std::vector<int> received;
+    stack.push(std::make_unique<InputState>(received, 0, false));
+    stack.push(std::make_unique<InputState>(received, 1, true));
+    stack.push(std::make_unique<InputState>(received, 2, false));
+
+    REQUIRE(stack.handleInput(InputEvent{}));
+    REQUIRE(received == std::vector<int>{2, 1});
+
+    received.clear();
+    stack.pop();
+    stack.pop();
+    REQUIRE_FALSE(stack.handleInput(InputEvent{}));
+    REQUIRE(received == std::vector<int>{0});
+}
+
+TEST_CASE("StateStack keeps input from reaching states under a modal state", "[StateStack]")
+{
+    StateStack stack;
+    std::vector<int> received;
+    stack.push(std::make_unique<InputState>(received, 0, false));
+    stack.push(std::make_unique<InputState>(received, 1, false, true));
+    stack.push(std::make_unique<InputState>(received, 2, false));
+
+    REQUIRE_FALSE(stack.handleInput(InputEvent{}));
+    REQUIRE(received == std::vector<int>{2, 1});
+
+    received.clear();
+    stack.pop();
+    stack.pop();
+    stack.handleInput(InputEvent{});
+    REQUIRE(received == std::vector<int>{0});
+}
+
+class OnDemandState : public GameState
+{
+public:
+    OnDemandState(bool continuous, bool coveredUpdates)
+        : continuous(continuous), coveredUpdates(coveredUpdates)
+    {
+    }
+
+    bool needsContinuousUpdates() const override
+    {
+        return continuous;
+    }
+
+    bool updatesWhenCovered() const override
+    {
+        return coveredUpdates;
+    }
+
+    void setContinuous(bool continuous)
+    {
+        this->continuous = continuous;
+    }
+
+private:
+    bool continuous, coveredUpdates;
+};
+
+TEST_CASE("StateStack needs continuous updates only while an updating state does", "[StateStack]")
+{
+    StateStack stack;
+    REQUIRE_FALSE(stack.needsContinuousUpdates());
+
+    stack.push(std::make_unique<OnDemandState>(true, false));
+    REQUIRE(stack.needsContinuousUpdates());
+
+    // Covered states that do not update cannot keep the game awake.
+    stack.push(std::make_unique<OnDemandState>(false, false));
+    REQUIRE_FALSE(stack.needsContinuousUpdates());
+
+    stack.pop();
+    stack.pop();
+    stack.push(std::make_unique<OnDemandState>(true, true));
+    stack.push(std::make_unique<OnDemandState>(false, false));
+    REQUIRE(stack.needsContinuousUpdates());
+}
+
+TEST_CASE("StateStack notices a state that becomes dirty without a transition", "[StateStack]")
+{
+    StateStack stack;
+    auto state = std::make_unique<OnDemandState>(false, false);
+    OnDemandState *onDemand = state.get();
+    stack.push(std::move(state));
+    REQUIRE_FALSE(stack.needsContinuousUpdates());
+
+    onDemand->setContinuous(true);
+    REQUIRE(stack.needsContinuousUpdates());
+
+    onDemand->setContinuous(false);
+    REQUIRE_FALSE(stack.needsContinuousUpdates());
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "rendering/atlas_layout.hpp"
+#include "rendering/texture2d.hpp"
+
+namespace
+{
+    // Each image is filled with its own colour so its pixels can be found
+    // again in the page.
+    struct SolidImage
+    {
+        SolidImage(std::string name, int width, int height, unsigned char shade)
+            : name(std::move(name)), width(width), height(height),
+              pixels(static_cast<size_t>(width) * height * 4, shade)
+        {
+        }
+
+        AtlasSource source() const
+        {
+            return {name, width, height, pixels.data()};
+        }
+
+        std::string name;
+        int width, height;
+        std::vector<unsigned char> pixels;
+    };
+
+    unsigned char shadeAt(const AtlasLayout &layout, size_t page, glm::vec2 uv)
+    {
+        int pageSize = layout.getPageSize();
+        int x = static_cast<int>(uv.x * pageSize),
+            y = static_cast<int>(uv.y * pageSize);
+        return layout.getPagePixels(page)[(static_cast<size_t>(y) * pageSize + x) * 4];
+    }
+}
+
+TEST_CASE("AtlasLayout rejects invalid sources and settings", "[AtlasLayout]")
+{
+    SolidImage image("a", 8, 8, 1);
+    REQUIRE_THROWS_WITH(AtlasLayout({image.source()}, 0), "AtlasLayout: pageSize must be positive");
+    REQUIRE_THROWS_WITH(AtlasLayout({image.source()}, 64, -1), "AtlasLayout: padding must not be negative");
+    REQUIRE_THROWS_WITH(AtlasLayout({image.source(), image.source()}, 64), "AtlasLayout: duplicate source a");
+    REQUIRE_THROWS_WITH(AtlasLayout({image.source()}, 8, 1), "AtlasLayout: source a does not fit in a page");
+    REQUIRE_THROWS_WITH(AtlasLayout({AtlasSource{"empty"}}, 64), "AtlasLayout: source empty has no pixels");
+}
+
+TEST_CASE("AtlasLayout maps every frame to its own pixels", "[AtlasLayout]")
+{
+    std::vector<SolidImage> images;
+    images.emplace_back("wide", 20, 6, 10);
+    images.emplace_back("tall", 6, 24, 20);
+    images.emplace_back("small", 4, 4, 30);
+    images.emplace_back("square", 12, 12, 40);
+
+    std::vector<AtlasSource> sources;
+    for (const SolidImage &image : images)
+        sources.push_back(image.source());
+
+    AtlasLayout layout(sources, 64, 1);
+    REQUIRE(layout.getFrameCount() == images.size());
+    REQUIRE(layout.getPageCount() == 1);
+
+    for (uint32_t frame = 0; frame < images.size(); ++frame)
+    {
+        const SolidImage &image = images[frame];
+        REQUIRE(layout.getFrameIndex(image.name) == frame);
+
+        const UVRect &uv = layout.getUV(frame);
+        REQUIRE(uv.min.x >= 0.0f);
+        REQUIRE(uv.min.y >= 0.0f);
+        REQUIRE(uv.max.x <= 1.0f);
+        REQUIRE(uv.max.y <= 1.0f);
+        REQUIRE((uv.max.x - uv.min.x) * 64 == image.width);
+        REQUIRE((uv.max.y - uv.min.y) * 64 == image.height);
+
+        // Both the frame and the padding extruded around it.
+        glm::vec2 texel(1.0f / 64);
+        REQUIRE(shadeAt(layout, 0, uv.min) == image.pixels[0]);
+        REQUIRE(shadeAt(layout, 0, uv.max - texel) == image.pixels[0]);
+        REQUIRE(shadeAt(layout, 0, uv.min - texel) == image.pixels[0]);
+        REQUIRE(shadeAt(layout, 0, uv.max) == image.pixels[0]);
+    }
+
+    REQUIRE_THROWS_AS(layout.getFrameIndex("missing"), std::runtime_error);
+    REQUIRE_THROWS_AS(layout.getUV(4), std::out_of_range);
+}
+
+TEST_CASE("AtlasLayout batched lookup matches single lookups", "[AtlasLayout]")
+{
+    std::vector<SolidImage> images;
+    for (int i = 0; i < 40; ++i)
+        images.emplace_back("frame" + std::to_string(i), 8 + i % 5, 8 + i % 3, static_cast<unsigned char>(i + 1));
+
+    std::vector<AtlasSource> sources;
+    for (const SolidImage &image : images)
+        sources.push_back(image.source());
+
+    // Small pages, so the frames spill over several of them.
+    AtlasLayout layout(sources, 32, 1);
+    REQUIRE(layout.getPageCount() > 1);
+
+    std::vector<uint32_t> frames;
+    for (uint32_t i = 0; i < 1000; ++i)
+        frames.push_back((i * 7) % 40);
+
+    std::vector<UVRect> uvs(frames.size());
+    layout.getUVs(frames, uvs);
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        REQUIRE(uvs[i].min == layout.getUV(frames[i]).min);
+        REQUIRE(uvs[i].max == layout.getUV(frames[i]).max);
+        REQUIRE(shadeAt(layout, layout.getPage(frames[i]), uvs[i].min) == images[frames[i]].pixels[0]);
+    }
+
+    std::vector<UVRect> tooSmall(frames.size() - 1);
+    REQUIRE_THROWS_AS(layout.getUVs(frames, tooSmall), std::invalid_argument);
+    frames.back() = 40;
+    REQUIRE_THROWS_AS(layout.getUVs(frames, uvs), std::out_of_range);
+
+    // Releasing the pixels keeps the table.
+    UVRect before = layout.getUV(3);
+    layout.releasePixels();
+    REQUIRE(layout.getPagePixels(0).empty());
+    REQUIRE(layout.getUV(3).min == before.min);
+    REQUIRE(layout.getUV(3).max == before.max);
+}
+
+TEST_CASE("Texture2D tile UVs cover a non-square grid", "[Texture2D]")
+{
+    // 64x32 in 16 pixel tiles is four columns by two rows.
+    auto [min, max] = Texture2D::getTileUVRange(64, 32, 5, 16);
+    REQUIRE(min == glm::vec2(0.25f, 0.5f));
+    REQUIRE(max == glm::vec2(0.5f, 1.0f));
+
+    auto [flippedMin, flippedMax] = Texture2D::getTileUVRange(64, 32, 5, 16, false);
+    REQUIRE(flippedMin == glm::vec2(0.25f, 1.0f));
+    REQUIRE(flippedMax == glm::vec2(0.5f, 0.5f));
+
+    REQUIRE_THROWS_WITH(Texture2D::getTileUVRange(64, 32, 0, 0), "Texture2D tileSize must be positive and fit the texture");
+    REQUIRE_THROWS_WITH(Texture2D::getTileUVRange(64, 32, 0, 48), "Texture2D tileSize must be positive and fit the texture");
+    REQUIRE_THROWS_WITH(Texture2D::getTileUVRange(64, 32, 8, 16), "Texture2D frameIndex is outside the tile grid");
+    REQUIRE_THROWS_WITH(Texture2D::getTileUVRange(64, 32, -1, 16), "Texture2D frameIndex is outside the tile grid");
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "core/thread_pool.hpp"
+
+TEST_CASE("ThreadPool rejects invalid arguments", "[ThreadPool]")
+{
+    REQUIRE_THROWS_WITH(ThreadPool(0), "ThreadPool: threadCount must be positive");
+    ThreadPool pool(1);
+    REQUIRE_THROWS_WITH(pool.submit(nullptr), "ThreadPool: submit received empty task");
+}
+
+TEST_CASE("ThreadPool runs every submitted task before shutting down", "[ThreadPool]")
+{
+    std::atomic<int> completed = 0;
+    {
+        ThreadPool pool(4);
+        REQUIRE(pool.getThreadCount() == 4);
+        for (int i = 0; i < 100; ++i)
+            pool.submit([&completed]()
+                        { ++completed; });
+    }
+    REQUIRE(completed == 100);
+}
\ No newline at end of file
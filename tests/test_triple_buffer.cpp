@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <thread>
+#include "core/triple_buffer.hpp"
+
+TEST_CASE("TripleBuffer hands over only published values", "[TripleBuffer]")
+{
+    TripleBuffer<int> buffer;
+    REQUIRE_FALSE(buffer.acquire());
+
+    buffer.getWriteBuffer() = 1;
+    buffer.publish();
+    REQUIRE(buffer.acquire());
+    REQUIRE(buffer.getReadBuffer() == 1);
+
+    // Nothing new: the reader keeps what it has.
+    REQUIRE_FALSE(buffer.acquire());
+    REQUIRE(buffer.getReadBuffer() == 1);
+
+    buffer.getWriteBuffer() = 2;
+    REQUIRE_FALSE(buffer.acquire());
+    REQUIRE(buffer.getReadBuffer() == 1);
+}
+
+TEST_CASE("TripleBuffer skips to the newest value", "[TripleBuffer]")
+{
+    TripleBuffer<int> buffer;
+    for (int i = 1; i <= 5; ++i)
+    {
+        buffer.getWriteBuffer() = i;
+        buffer.publish();
+    }
+
+    REQUIRE(buffer.acquire());
+    REQUIRE(buffer.getReadBuffer() == 5);
+    REQUIRE_FALSE(buffer.acquire());
+}
+
+TEST_CASE("TripleBuffer never gives the writer the buffer being read", "[TripleBuffer]")
+{
+    TripleBuffer<int> buffer;
+    buffer.getWriteBuffer() = 1;
+    buffer.publish();
+    REQUIRE(buffer.acquire());
+    const int *reading = &buffer.getReadBuffer();
+
+    for (int i = 2; i < 10; ++i)
+    {
+        REQUIRE(&buffer.getWriteBuffer() != reading);
+        buffer.getWriteBuffer() = i;
+        buffer.publish();
+    }
+    REQUIRE(*reading == 1);
+}
+
+TEST_CASE("TripleBuffer delivers whole values in order across threads", "[TripleBuffer]")
+{
+    struct Frame
+    {
+        uint64_t index = 0,
+                 check = 0;
+    };
+
+    constexpr uint64_t frameCount = 100000;
+    TripleBuffer<Frame> buffer;
+
+    std::thread writer([&buffer]
+                       {
+        for (uint64_t i = 1; i <= frameCount; ++i)
+        {
+            Frame &frame = buffer.getWriteBuffer();
+            frame.index = i;
+            frame.check = i * 31;
+            buffer.publish();
+        } });
+
+    uint64_t last = 0;
+    bool torn = false,
+         backwards = false;
+    while (last < frameCount)
+    {
+        if (!buffer.acquire())
+            continue;
+
+        const Frame &frame = buffer.getReadBuffer();
+        torn |= frame.check != frame.index * 31;
+        backwards |= frame.index <= last;
+        last = frame.index;
+    }
+    writer.join();
+
+    REQUIRE_FALSE(torn);
+    REQUIRE_FALSE(backwards);
+}
\ No newline at end of file
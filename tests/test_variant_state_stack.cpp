@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <string>
+#include <vector>
+#include "game/states/game_state.hpp"
+#include "game/states/variant_state_stack.hpp"
+
+namespace
+{
+    using Log = std::vector<std::string>;
+
+    struct WorldState
+    {
+        Log *log;
+        bool background = false;
+        int updates = 0;
+
+        void onEnter() { log->push_back("World.onEnter"); }
+        void onPause() { log->push_back("World.onPause"); }
+        void onResume() { log->push_back("World.onResume"); }
+        void update(float dt) { ++updates; }
+        void render(float alpha) { log->push_back("World.render"); }
+        bool isOpaque() const { return true; }
+        bool updatesWhenCovered() const { return background; }
+    };
+
+    // Declares no hooks at all apart from render.
+    struct HudState
+    {
+        Log *log;
+
+        void render(float alpha) { log->push_back("Hud.render"); }
+    };
+
+    class MenuState : public GameState
+    {
+    public:
+        explicit MenuState(Log *log) : log(log) {}
+
+        void onEnter() override { log->push_back("Menu.onEnter"); }
+        void onExit() override { log->push_back("Menu.onExit"); }
+        void update(float dt) override { log->push_back("Menu.update"); }
+        void render(float alpha) override { log->push_back("Menu.render"); }
+
+    private:
+        Log *log;
+    };
+
+    using TestStack = VariantStateStack<WorldState, HudState, MenuState>;
+
+    struct ClosingState;
+    using TransitionStack = VariantStateStack<WorldState, HudState, ClosingState>;
+
+    struct ClosingState
+    {
+        TransitionStack *stack;
+        Log *log;
+
+        void update(float dt)
+        {
+            stack->pop();
+            stack->push<HudState>(log);
+            log->push_back(stack->size() == 2 ? "deferred" : "applied");
+        }
+    };
+}
+
+TEST_CASE("VariantStateStack pushes, pops and replaces states in place", "[VariantStateStack]")
+{
+    Log log;
+    TestStack stack;
+    REQUIRE_THROWS_WITH(stack.top(), "VariantStateStack: top called on empty stack");
+
+    stack.push<WorldState>(&log);
+    stack.push<MenuState>(&log);
+    REQUIRE(stack.size() == 2);
+    REQUIRE(std::holds_alternative<MenuState>(stack.top()));
+
+    stack.replace<HudState>(&log);
+    REQUIRE(stack.size() == 2);
+    REQUIRE(std::holds_alternative<HudState>(stack.top()));
+
+    stack.pop();
+    REQUIRE(std::holds_alternative<WorldState>(stack.top()));
+    REQUIRE(log == Log{"World.onEnter", "World.onPause", "Menu.onEnter", "Menu.onExit", "World.onResume"});
+}
+
+TEST_CASE("VariantStateStack renders from the topmost opaque state and updates the top", "[VariantStateStack]")
+{
+    Log log;
+    TestStack stack;
+    stack.push<HudState>(&log);
+    stack.push<WorldState>(&log);
+    stack.push<MenuState>(&log);
+    log.clear();
+
+    stack.update(0.01f);
+    stack.render();
+    REQUIRE(log == Log{"Menu.update", "World.render", "Menu.render"});
+}
+
+TEST_CASE("VariantStateStack updates covered states that ask for it", "[VariantStateStack]")
+{
+    Log log;
+    TestStack stack;
+    stack.push<WorldState>(&log, true);
+    stack.push<HudState>(&log);
+    stack.update(0.01f);
+    stack.update(0.01f);
+
+    stack.pop();
+    REQUIRE(std::get<WorldState>(stack.top()).updates == 2);
+}
+
+TEST_CASE("VariantStateStack defers transitions requested during update", "[VariantStateStack]")
+{
+    Log log;
+    TransitionStack stack;
+    stack.push<WorldState>(&log);
+    stack.push<ClosingState>(&stack, &log);
+    log.clear();
+
+    stack.update(0.01f);
+    REQUIRE_FALSE(stack.hasPendingChanges());
+    REQUIRE(stack.size() == 2);
+    REQUIRE(std::holds_alternative<HudState>(stack.top()));
+    REQUIRE(log == Log{"deferred"});
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <vector>
+#include "rendering/ui/view_transform.hpp"
+
+using Catch::Matchers::WithinRel;
+
+namespace
+{
+    // Odd counts leave a scalar tail after the vector loop.
+    constexpr size_t pointCount = 37;
+    const glm::vec2 cameraTopLeft(-120.0f, 64.0f);
+    const glm::vec2 uiScale(2.0f, 1.5f);
+    constexpr float zoom = 1.25f;
+
+    glm::vec2 referenceWorldToScreen(glm::vec2 world)
+    {
+        return ((world - cameraTopLeft) * zoom) / uiScale;
+    }
+
+    std::vector<glm::vec2> makePoints()
+    {
+        std::vector<glm::vec2> points;
+        for (size_t i = 0; i < pointCount; ++i)
+            points.emplace_back(static_cast<float>(i) * 13.5f - 200.0f, static_cast<float>(i) * -7.25f + 40.0f);
+        return points;
+    }
+}
+
+TEST_CASE("ViewTransform batch AoS conversion matches the per point formula and round trips", "[ViewTransform]")
+{
+    ViewTransform transform = ViewTransform::create(zoom, cameraTopLeft, uiScale);
+    std::vector<glm::vec2> world = makePoints();
+    std::vector<ImVec2> screen(world.size());
+    worldToScreen(transform, world, screen);
+
+    for (size_t i = 0; i < world.size(); ++i)
+    {
+        glm::vec2 expected = referenceWorldToScreen(world[i]);
+        REQUIRE_THAT(screen[i].x, WithinRel(expected.x, 1e-5f));
+        REQUIRE_THAT(screen[i].y, WithinRel(expected.y, 1e-5f));
+    }
+
+    std::vector<glm::vec2> roundTrip(world.size());
+    screenToWorld(transform, screen, roundTrip);
+    for (size_t i = 0; i < world.size(); ++i)
+    {
+        REQUIRE_THAT(roundTrip[i].x, WithinRel(world[i].x, 1e-5f));
+        REQUIRE_THAT(roundTrip[i].y, WithinRel(world[i].y, 1e-5f));
+    }
+}
+
+TEST_CASE("ViewTransform batch SoA conversion matches AoS", "[ViewTransform]")
+{
+    ViewTransform transform = ViewTransform::create(zoom, cameraTopLeft, uiScale);
+    std::vector<glm::vec2> world = makePoints();
+    std::vector<ImVec2> screen(world.size());
+    worldToScreen(transform, world, screen);
+
+    std::vector<float> worldX, worldY;
+    for (glm::vec2 point : world)
+    {
+        worldX.push_back(point.x);
+        worldY.push_back(point.y);
+    }
+    std::vector<float> screenX(world.size()), screenY(world.size());
+    worldToScreen(transform, worldX, worldY, screenX, screenY);
+    for (size_t i = 0; i < world.size(); ++i)
+    {
+        REQUIRE(screenX[i] == screen[i].x);
+        REQUIRE(screenY[i] == screen[i].y);
+    }
+
+    // Converting in place is allowed.
+    screenToWorld(transform, screenX, screenY, screenX, screenY);
+    for (size_t i = 0; i < world.size(); ++i)
+    {
+        REQUIRE_THAT(screenX[i], WithinRel(world[i].x, 1e-5f));
+        REQUIRE_THAT(screenY[i], WithinRel(world[i].y, 1e-5f));
+    }
+}
+
+TEST_CASE("ViewTransform rejects mismatched spans and non-positive zoom", "[ViewTransform]")
+{
+    ViewTransform transform = ViewTransform::create(zoom, cameraTopLeft, uiScale);
+    std::vector<glm::vec2> world(4);
+    std::vector<ImVec2> screen(3);
+    REQUIRE_THROWS_WITH(worldToScreen(transform, world, screen), "worldToScreen: output size does not match input size");
+    REQUIRE_THROWS_WITH(ViewTransform::create(0.0f, cameraTopLeft, uiScale), "ViewTransform: zoom must be positive");
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "rendering/cooked_texture.hpp"
+#include "rendering/image.hpp"
+
+namespace
+{
+    CookedTextureFormat parseFormat(const std::string &name)
+    {
+        if (name == "rgba8")
+            return CookedTextureFormat::RGBA8;
+        if (name == "bc1")
+            return CookedTextureFormat::BC1;
+        if (name == "bc3")
+            return CookedTextureFormat::BC3;
+
+        throw std::invalid_argument("Unknown format " + name + " (expected rgba8, bc1 or bc3)");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage: texture_cooker <input image> <output.gtex> [--format rgba8|bc1|bc3] [--no-mips] [--flip]" << std::endl;
+        return -1;
+    }
+
+    try
+    {
+        std::string inputPath = argv[1],
+                    outputPath = argv[2];
+        CookedTextureFormat format = CookedTextureFormat::RGBA8;
+        bool generateMips = true,
+             flipY = false;
+
+        for (int i = 3; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+            if (argument == "--format" && i + 1 < argc)
+                format = parseFormat(argv[++i]);
+            else if (argument == "--no-mips")
+                generateMips = false;
+            else if (argument == "--flip")
+                flipY = true;
+            else
+                throw std::invalid_argument("Unknown argument " + argument);
+        }
+
+        Image image(inputPath, flipY);
+        std::vector<unsigned char> bytes = CookedTexture::cook(
+            image.getWidth(), image.getHeight(), image.getPixels(), format, generateMips);
+
+        std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+        if (!output)
+            throw std::runtime_error("Failed to open " + outputPath);
+
+        output.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!output)
+            throw std::runtime_error("Failed to write " + outputPath);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
\ No newline at end of file